@@ -0,0 +1,206 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Adjacency list implementation file.
+ *
+ * Vertex has no capacity field, so a list's capacity is implied by its
+ * length: the smallest power of two holding numNeighbors. An append that
+ * reaches a power of two doubles the array, which makes appends amortized
+ * O(1) instead of one realloc per edge.
+ *
+ * Once the capacity reaches HUB_CAPACITY, the same allocation also holds an
+ * open-addressing table of neighbor labels, twice the capacity in size, right
+ * after the pointer slots:
+ *
+ *   neighbors[0, capacity)   Vertex* slots, the first numNeighbors in use
+ *   table[0, 2 * capacity)   label + 1 of each neighbor, 0 for empty
+ *
+ * Membership tests on such hubs hash instead of scanning, and short lists
+ * are scanned. Every neighbors array must be allocated with this layout, so
+ * code that builds adjacency lists goes through adjacencyAllocate.
+ */
+
+#include "adjacency.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * Returns the capacity implied by a list length.
+ * @param numNeighbors
+ * @return The smallest power of two >= numNeighbors, or 0 if 0.
+ */
+int adjacencyCapacity(int numNeighbors)
+{
+    int capacity = 1;
+    if (numNeighbors == 0)
+    {
+        return 0;
+    }
+    while (capacity < numNeighbors)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * Returns the size in bytes of a list allocation of the given capacity.
+ * @param capacity
+ * @return Size in bytes.
+ */
+static size_t allocationSize(int capacity)
+{
+    size_t size = sizeof(Vertex*) * (size_t)capacity;
+    if (capacity >= HUB_CAPACITY)
+    {
+        size += sizeof(uint32_t) * 2 * (size_t)capacity;
+    }
+    return size;
+}
+
+/**
+ * Returns the label table of a hub list.
+ * @param vertex
+ * @param capacity
+ * @return The table of 2 * capacity slots.
+ */
+static uint32_t* labelTable(Vertex* vertex, int capacity)
+{
+    return (uint32_t*)(vertex->neighbors + capacity);
+}
+
+/**
+ * Returns the first table slot to probe for a label.
+ * @param label
+ * @param capacity
+ * @return Slot index in [0, 2 * capacity).
+ */
+static uint32_t labelSlot(int label, int capacity)
+{
+    return ((uint32_t)label * 2654435761u) & (uint32_t)(2 * capacity - 1);
+}
+
+/**
+ * Adds a label to a hub's table.
+ * @param table
+ * @param capacity
+ * @param label
+ */
+static void tableInsert(uint32_t* table, int capacity, int label)
+{
+    uint32_t mask = (uint32_t)(2 * capacity - 1);
+    uint32_t slot = labelSlot(label, capacity);
+    while (table[slot] != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    table[slot] = (uint32_t)label + 1;
+}
+
+/**
+ * Gives the vertex a neighbors array with room for numNeighbors and sets
+ * numNeighbors. The caller fills in the neighbors and then calls
+ * adjacencyIndex. Any previous array is not freed.
+ * @param vertex
+ * @param numNeighbors
+ */
+void adjacencyAllocate(Vertex* vertex, int numNeighbors)
+{
+    assert(numNeighbors >= 0);
+    vertex->numNeighbors = numNeighbors;
+    vertex->neighbors = NULL;
+    if (numNeighbors > 0)
+    {
+        vertex->neighbors = malloc(
+            allocationSize(adjacencyCapacity(numNeighbors)));
+        assert(vertex->neighbors != 0);
+    }
+}
+
+/**
+ * Rebuilds the label table of a hub from its neighbors. Does nothing for
+ * short lists.
+ * @param vertex
+ */
+void adjacencyIndex(Vertex* vertex)
+{
+    int capacity = adjacencyCapacity(vertex->numNeighbors);
+    if (capacity < HUB_CAPACITY)
+    {
+        return;
+    }
+    uint32_t* table = labelTable(vertex, capacity);
+    memset(table, 0, sizeof(uint32_t) * 2 * (size_t)capacity);
+    for (int i = 0; i < vertex->numNeighbors; ++i)
+    {
+        tableInsert(table, capacity, vertex->neighbors[i]->label);
+    }
+}
+
+/**
+ * Appends a neighbor to the vertex's list, doubling the array when it is
+ * full. Does not check for duplicates.
+ * @param vertex
+ * @param neighbor
+ */
+void adjacencyAppend(Vertex* vertex, Vertex* neighbor)
+{
+    int numNeighbors = vertex->numNeighbors;
+    int capacity = adjacencyCapacity(numNeighbors);
+    if (numNeighbors == capacity)
+    {
+        int newCapacity = capacity == 0 ? 1 : 2 * capacity;
+        vertex->neighbors = realloc(vertex->neighbors,
+                                    allocationSize(newCapacity));
+        assert(vertex->neighbors != 0);
+        vertex->neighbors[numNeighbors] = neighbor;
+        ++(vertex->numNeighbors);
+
+        /* The table moved with the capacity, so rebuild it. */
+        adjacencyIndex(vertex);
+        return;
+    }
+    vertex->neighbors[numNeighbors] = neighbor;
+    ++(vertex->numNeighbors);
+    if (capacity >= HUB_CAPACITY)
+    {
+        tableInsert(labelTable(vertex, capacity), capacity, neighbor->label);
+    }
+}
+
+/**
+ * Determines if the neighbor is in the vertex's list, by hashing for hubs
+ * and by scanning at most HUB_CAPACITY / 2 entries otherwise.
+ * @param vertex
+ * @param neighbor
+ * @return 1 if it is, 0 otherwise.
+ */
+int adjacencyContains(Vertex* vertex, Vertex* neighbor)
+{
+    int capacity = adjacencyCapacity(vertex->numNeighbors);
+    if (capacity < HUB_CAPACITY)
+    {
+        for (int i = 0; i < vertex->numNeighbors; ++i)
+        {
+            if (vertex->neighbors[i] == neighbor)
+            {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    uint32_t* table = labelTable(vertex, capacity);
+    uint32_t mask = (uint32_t)(2 * capacity - 1);
+    uint32_t key = (uint32_t)neighbor->label + 1;
+    for (uint32_t slot = labelSlot(neighbor->label, capacity);
+         table[slot] != 0; slot = (slot + 1) & mask)
+    {
+        if (table[slot] == key)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Growable vertex adjacency lists with constant time membership tests.
+ */
+
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include "graph.h"
+
+/* Lists with at least this capacity also keep a hash table of labels. */
+#define HUB_CAPACITY 64
+
+int adjacencyCapacity(int numNeighbors);
+void adjacencyAllocate(Vertex* vertex, int numNeighbors);
+void adjacencyIndex(Vertex* vertex);
+void adjacencyAppend(Vertex* vertex, Vertex* neighbor);
+int adjacencyContains(Vertex* vertex, Vertex* neighbor);
+
+#endif
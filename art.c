@@ -0,0 +1,798 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Adaptive radix tree (ART) implementation file.
+ *
+ * Inner nodes grow through four sizes (4, 16, 48 and 256 children) so that
+ * sparse and dense byte positions both stay compact. Runs of single-child
+ * nodes are collapsed into a per-node prefix; only the first ART_MAX_PREFIX
+ * bytes of it are stored and the rest is checked against a leaf. Keys are
+ * stored with their '\0' terminator, which guarantees no key is a prefix of
+ * another and keeps every leaf below an inner node.
+ */
+
+#include "art.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define ART_MAX_PREFIX 10
+
+#define IS_LEAF(x) (((uintptr_t)(x)) & 1)
+#define SET_LEAF(x) ((void*)((uintptr_t)(x) | 1))
+#define LEAF_RAW(x) ((ArtLeaf*)((uintptr_t)(x) & ~(uintptr_t)1))
+
+enum ArtNodeType
+{
+    NODE4 = 1,
+    NODE16,
+    NODE48,
+    NODE256
+};
+
+typedef struct ArtLeaf ArtLeaf;
+typedef struct ArtNode ArtNode;
+typedef struct ArtNode4 ArtNode4;
+typedef struct ArtNode16 ArtNode16;
+typedef struct ArtNode48 ArtNode48;
+typedef struct ArtNode256 ArtNode256;
+
+struct ArtLeaf
+{
+    int value;
+    int keyLength;     /* Including the '\0' */
+    char key[];
+};
+
+struct ArtNode
+{
+    unsigned char type;
+    unsigned short numChildren;
+    int prefixLength;
+    unsigned char prefix[ART_MAX_PREFIX];
+};
+
+struct ArtNode4
+{
+    ArtNode n;
+    unsigned char keys[4];
+    void* children[4];
+};
+
+struct ArtNode16
+{
+    ArtNode n;
+    unsigned char keys[16];
+    void* children[16];
+};
+
+struct ArtNode48
+{
+    ArtNode n;
+    unsigned char index[256];   /* Child slot + 1, or 0 if absent */
+    void* children[48];
+};
+
+struct ArtNode256
+{
+    ArtNode n;
+    void* children[256];
+};
+
+struct ArtTree
+{
+    void* root;
+    int size;
+};
+
+static int min(int a, int b)
+{
+    return a < b ? a : b;
+}
+
+/**
+ * Allocates a zeroed inner node of the given type.
+ * @param type
+ * @return The node.
+ */
+static ArtNode* nodeNew(unsigned char type)
+{
+    ArtNode* node;
+    switch (type)
+    {
+        case NODE4: node = calloc(1, sizeof(ArtNode4)); break;
+        case NODE16: node = calloc(1, sizeof(ArtNode16)); break;
+        case NODE48: node = calloc(1, sizeof(ArtNode48)); break;
+        default: node = calloc(1, sizeof(ArtNode256)); break;
+    }
+    assert(node != 0);
+    node->type = type;
+    return node;
+}
+
+/**
+ * Allocates a leaf holding a copy of the key.
+ * @param key
+ * @param keyLength Length of the key including the '\0'.
+ * @param value
+ * @return The leaf.
+ */
+static ArtLeaf* leafNew(const unsigned char* key, int keyLength, int value)
+{
+    ArtLeaf* leaf = malloc(sizeof(ArtLeaf) + keyLength);
+    assert(leaf != 0);
+    leaf->value = value;
+    leaf->keyLength = keyLength;
+    memcpy(leaf->key, key, keyLength);
+    return leaf;
+}
+
+static int leafMatches(ArtLeaf* leaf, const unsigned char* key, int keyLength)
+{
+    return leaf->keyLength == keyLength
+        && memcmp(leaf->key, key, keyLength) == 0;
+}
+
+/**
+ * Frees a node, all nodes below it and their leaves.
+ * @param node
+ */
+static void nodeDelete(void* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+    if (IS_LEAF(node))
+    {
+        free(LEAF_RAW(node));
+        return;
+    }
+    ArtNode* n = node;
+    switch (n->type)
+    {
+        case NODE4:
+            for (int i = 0; i < n->numChildren; i++)
+            {
+                nodeDelete(((ArtNode4*)n)->children[i]);
+            }
+            break;
+        case NODE16:
+            for (int i = 0; i < n->numChildren; i++)
+            {
+                nodeDelete(((ArtNode16*)n)->children[i]);
+            }
+            break;
+        case NODE48:
+            for (int i = 0; i < n->numChildren; i++)
+            {
+                nodeDelete(((ArtNode48*)n)->children[i]);
+            }
+            break;
+        default:
+            for (int i = 0; i < 256; i++)
+            {
+                nodeDelete(((ArtNode256*)n)->children[i]);
+            }
+            break;
+    }
+    free(n);
+}
+
+/**
+ * Returns the child slot for the given byte, or NULL if there is none.
+ * @param n
+ * @param c
+ * @return Pointer to the child pointer or NULL.
+ */
+static void** findChild(ArtNode* n, unsigned char c)
+{
+    switch (n->type)
+    {
+        case NODE4:
+        {
+            ArtNode4* node = (ArtNode4*)n;
+            for (int i = 0; i < n->numChildren; i++)
+            {
+                if (node->keys[i] == c)
+                {
+                    return &node->children[i];
+                }
+            }
+            return NULL;
+        }
+        case NODE16:
+        {
+            ArtNode16* node = (ArtNode16*)n;
+            for (int i = 0; i < n->numChildren && node->keys[i] <= c; i++)
+            {
+                if (node->keys[i] == c)
+                {
+                    return &node->children[i];
+                }
+            }
+            return NULL;
+        }
+        case NODE48:
+        {
+            ArtNode48* node = (ArtNode48*)n;
+            int slot = node->index[c];
+            return slot ? &node->children[slot - 1] : NULL;
+        }
+        default:
+        {
+            ArtNode256* node = (ArtNode256*)n;
+            return node->children[c] ? &node->children[c] : NULL;
+        }
+    }
+}
+
+/**
+ * Returns the leaf with the smallest key below the given node.
+ * @param node
+ * @return The leaf.
+ */
+static ArtLeaf* minimumLeaf(void* node)
+{
+    while (!IS_LEAF(node))
+    {
+        ArtNode* n = node;
+        switch (n->type)
+        {
+            case NODE4:
+                node = ((ArtNode4*)n)->children[0];
+                break;
+            case NODE16:
+                node = ((ArtNode16*)n)->children[0];
+                break;
+            case NODE48:
+            {
+                ArtNode48* n48 = (ArtNode48*)n;
+                int c = 0;
+                while (!n48->index[c])
+                {
+                    c++;
+                }
+                node = n48->children[n48->index[c] - 1];
+                break;
+            }
+            default:
+            {
+                ArtNode256* n256 = (ArtNode256*)n;
+                int c = 0;
+                while (!n256->children[c])
+                {
+                    c++;
+                }
+                node = n256->children[c];
+                break;
+            }
+        }
+    }
+    return LEAF_RAW(node);
+}
+
+/**
+ * Returns the number of bytes of the node's prefix that match the key from
+ * the given depth. Bytes past the stored part of the prefix are compared
+ * against the minimum leaf below the node.
+ * @param n
+ * @param key
+ * @param keyLength
+ * @param depth
+ * @return Length of the matching prefix.
+ */
+static int prefixMismatch(ArtNode* n, const unsigned char* key, int keyLength,
+                          int depth)
+{
+    int maxCompare = min(min(ART_MAX_PREFIX, n->prefixLength),
+                         keyLength - depth);
+    int i;
+    for (i = 0; i < maxCompare; i++)
+    {
+        if (n->prefix[i] != key[depth + i])
+        {
+            return i;
+        }
+    }
+    if (n->prefixLength > ART_MAX_PREFIX)
+    {
+        ArtLeaf* leaf = minimumLeaf(n);
+        maxCompare = min(min(leaf->keyLength, keyLength) - depth,
+                         n->prefixLength);
+        for (; i < maxCompare; i++)
+        {
+            if ((unsigned char)leaf->key[depth + i] != key[depth + i])
+            {
+                return i;
+            }
+        }
+    }
+    return i;
+}
+
+static void addChild(ArtNode* n, void** ref, unsigned char c, void* child);
+
+static void addChild256(ArtNode256* node, unsigned char c, void* child)
+{
+    node->n.numChildren++;
+    node->children[c] = child;
+}
+
+static void addChild48(ArtNode48* node, void** ref, unsigned char c,
+                       void* child)
+{
+    if (node->n.numChildren < 48)
+    {
+        int slot = 0;
+        while (node->children[slot])
+        {
+            slot++;
+        }
+        node->children[slot] = child;
+        node->index[c] = (unsigned char)(slot + 1);
+        node->n.numChildren++;
+        return;
+    }
+    ArtNode256* bigger = (ArtNode256*)nodeNew(NODE256);
+    for (int i = 0; i < 256; i++)
+    {
+        if (node->index[i])
+        {
+            bigger->children[i] = node->children[node->index[i] - 1];
+        }
+    }
+    bigger->n.numChildren = node->n.numChildren;
+    bigger->n.prefixLength = node->n.prefixLength;
+    memcpy(bigger->n.prefix, node->n.prefix, ART_MAX_PREFIX);
+    *ref = bigger;
+    free(node);
+    addChild256(bigger, c, child);
+}
+
+/**
+ * Inserts a child into a sorted key array of the given node size, growing the
+ * node when it is full.
+ */
+static void addChildSorted(ArtNode* n, unsigned char* keys, void** children,
+                           int capacity, void** ref, unsigned char c,
+                           void* child)
+{
+    int count = n->numChildren;
+    if (count < capacity)
+    {
+        int i = 0;
+        while (i < count && keys[i] < c)
+        {
+            i++;
+        }
+        memmove(keys + i + 1, keys + i, count - i);
+        memmove(children + i + 1, children + i, sizeof(void*) * (count - i));
+        keys[i] = c;
+        children[i] = child;
+        n->numChildren++;
+        return;
+    }
+    
+    ArtNode* bigger;
+    if (capacity == 4)
+    {
+        ArtNode16* n16 = (ArtNode16*)nodeNew(NODE16);
+        memcpy(n16->keys, keys, count);
+        memcpy(n16->children, children, sizeof(void*) * count);
+        bigger = &n16->n;
+    }
+    else
+    {
+        ArtNode48* n48 = (ArtNode48*)nodeNew(NODE48);
+        memcpy(n48->children, children, sizeof(void*) * count);
+        for (int i = 0; i < count; i++)
+        {
+            n48->index[keys[i]] = (unsigned char)(i + 1);
+        }
+        bigger = &n48->n;
+    }
+    bigger->numChildren = n->numChildren;
+    bigger->prefixLength = n->prefixLength;
+    memcpy(bigger->prefix, n->prefix, ART_MAX_PREFIX);
+    *ref = bigger;
+    free(n);
+    addChild(bigger, ref, c, child);
+}
+
+/**
+ * Adds a child for the given byte, replacing the node through ref if it has
+ * to grow.
+ * @param n
+ * @param ref Pointer to the slot holding n.
+ * @param c
+ * @param child
+ */
+static void addChild(ArtNode* n, void** ref, unsigned char c, void* child)
+{
+    switch (n->type)
+    {
+        case NODE4:
+            addChildSorted(n, ((ArtNode4*)n)->keys, ((ArtNode4*)n)->children,
+                           4, ref, c, child);
+            break;
+        case NODE16:
+            addChildSorted(n, ((ArtNode16*)n)->keys,
+                           ((ArtNode16*)n)->children, 16, ref, c, child);
+            break;
+        case NODE48:
+            addChild48((ArtNode48*)n, ref, c, child);
+            break;
+        default:
+            addChild256((ArtNode256*)n, c, child);
+            break;
+    }
+}
+
+/**
+ * Finds the leaf for the key below the node at ref, inserting a new leaf with
+ * the given initial value if there is none.
+ * @param ref Pointer to the slot holding the subtree root.
+ * @param key
+ * @param keyLength Length of the key including the '\0'.
+ * @param depth Number of key bytes consumed above this node.
+ * @param value Initial value for a new leaf.
+ * @param isNew Set to 1 if a leaf was inserted.
+ * @return Pointer to the leaf's value.
+ */
+static int* insert(void** ref, const unsigned char* key, int keyLength,
+                   int depth, int value, int* isNew)
+{
+    while (1)
+    {
+        void* node = *ref;
+        if (node == NULL)
+        {
+            ArtLeaf* leaf = leafNew(key, keyLength, value);
+            *ref = SET_LEAF(leaf);
+            *isNew = 1;
+            return &leaf->value;
+        }
+        
+        if (IS_LEAF(node))
+        {
+            ArtLeaf* leaf = LEAF_RAW(node);
+            if (leafMatches(leaf, key, keyLength))
+            {
+                return &leaf->value;
+            }
+            /* Split the leaf into a node holding both keys. */
+            ArtNode* split = nodeNew(NODE4);
+            ArtLeaf* added = leafNew(key, keyLength, value);
+            int common = 0;
+            while ((unsigned char)leaf->key[depth + common]
+                   == key[depth + common])
+            {
+                common++;
+            }
+            split->prefixLength = common;
+            memcpy(split->prefix, key + depth, min(ART_MAX_PREFIX, common));
+            *ref = split;
+            addChild(split, ref, (unsigned char)leaf->key[depth + common],
+                     SET_LEAF(leaf));
+            addChild(split, ref, key[depth + common], SET_LEAF(added));
+            *isNew = 1;
+            return &added->value;
+        }
+        
+        ArtNode* n = node;
+        if (n->prefixLength)
+        {
+            int match = prefixMismatch(n, key, keyLength, depth);
+            if (match < n->prefixLength)
+            {
+                /* Split the prefix at the first differing byte. */
+                ArtNode* split = nodeNew(NODE4);
+                split->prefixLength = match;
+                memcpy(split->prefix, n->prefix, min(ART_MAX_PREFIX, match));
+                *ref = split;
+                if (n->prefixLength <= ART_MAX_PREFIX)
+                {
+                    addChild(split, ref, n->prefix[match], n);
+                    n->prefixLength -= match + 1;
+                    memmove(n->prefix, n->prefix + match + 1,
+                            min(ART_MAX_PREFIX, n->prefixLength));
+                }
+                else
+                {
+                    ArtLeaf* leaf = minimumLeaf(n);
+                    addChild(split, ref,
+                             (unsigned char)leaf->key[depth + match], n);
+                    n->prefixLength -= match + 1;
+                    memcpy(n->prefix, leaf->key + depth + match + 1,
+                           min(ART_MAX_PREFIX, n->prefixLength));
+                }
+                ArtLeaf* added = leafNew(key, keyLength, value);
+                addChild(split, ref, key[depth + match], SET_LEAF(added));
+                *isNew = 1;
+                return &added->value;
+            }
+            depth += n->prefixLength;
+        }
+        
+        void** child = findChild(n, key[depth]);
+        if (child == NULL)
+        {
+            ArtLeaf* added = leafNew(key, keyLength, value);
+            addChild(n, ref, key[depth], SET_LEAF(added));
+            *isNew = 1;
+            return &added->value;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+/**
+ * Calls visit on every leaf below the node in key order.
+ * @param node
+ * @param visit
+ * @param context
+ * @return Number of leaves visited.
+ */
+static int visitAll(void* node, ArtVisitFunction visit, void* context)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    if (IS_LEAF(node))
+    {
+        ArtLeaf* leaf = LEAF_RAW(node);
+        visit(leaf->key, leaf->value, context);
+        return 1;
+    }
+    int count = 0;
+    ArtNode* n = node;
+    switch (n->type)
+    {
+        case NODE4:
+            for (int i = 0; i < n->numChildren; i++)
+            {
+                count += visitAll(((ArtNode4*)n)->children[i], visit,
+                                  context);
+            }
+            break;
+        case NODE16:
+            for (int i = 0; i < n->numChildren; i++)
+            {
+                count += visitAll(((ArtNode16*)n)->children[i], visit,
+                                  context);
+            }
+            break;
+        case NODE48:
+        {
+            ArtNode48* n48 = (ArtNode48*)n;
+            for (int c = 0; c < 256; c++)
+            {
+                if (n48->index[c])
+                {
+                    count += visitAll(n48->children[n48->index[c] - 1],
+                                      visit, context);
+                }
+            }
+            break;
+        }
+        default:
+            for (int c = 0; c < 256; c++)
+            {
+                count += visitAll(((ArtNode256*)n)->children[c], visit,
+                                  context);
+            }
+            break;
+    }
+    return count;
+}
+
+/**
+ * Allocates an empty tree.
+ * @return The tree.
+ */
+ArtTree* artNew(void)
+{
+    ArtTree* tree = malloc(sizeof(ArtTree));
+    assert(tree != 0);
+    tree->root = NULL;
+    tree->size = 0;
+    return tree;
+}
+
+/**
+ * Frees all nodes and leaves of the tree and the tree itself.
+ * @param tree
+ */
+void artDelete(ArtTree* tree)
+{
+    nodeDelete(tree->root);
+    free(tree);
+}
+
+/**
+ * Returns a pointer to the value for the given key, or NULL if the key is not
+ * in the tree.
+ * @param tree
+ * @param key
+ * @return Pointer to the value or NULL.
+ */
+int* artGet(ArtTree* tree, const char* key)
+{
+    const unsigned char* k = (const unsigned char*)key;
+    int keyLength = (int)strlen(key) + 1;
+    void* node = tree->root;
+    int depth = 0;
+    while (node != NULL)
+    {
+        if (IS_LEAF(node))
+        {
+            ArtLeaf* leaf = LEAF_RAW(node);
+            return leafMatches(leaf, k, keyLength) ? &leaf->value : NULL;
+        }
+        ArtNode* n = node;
+        if (n->prefixLength)
+        {
+            /* Only the stored bytes are checked, the leaf compare covers the
+             * rest. */
+            int stored = min(ART_MAX_PREFIX, n->prefixLength);
+            if (n->prefixLength > keyLength - depth
+                || memcmp(n->prefix, k + depth, stored) != 0)
+            {
+                return NULL;
+            }
+            depth += n->prefixLength;
+        }
+        if (depth >= keyLength)
+        {
+            return NULL;
+        }
+        void** child = findChild(n, k[depth]);
+        node = child ? *child : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+/**
+ * Sets the value for the given key, adding the key if it is not in the tree.
+ * @param tree
+ * @param key
+ * @param value
+ */
+void artPut(ArtTree* tree, const char* key, int value)
+{
+    int isNew = 0;
+    int* slot = insert(&tree->root, (const unsigned char*)key,
+                       (int)strlen(key) + 1, 0, value, &isNew);
+    *slot = value;
+    tree->size += isNew;
+}
+
+/**
+ * Adds amount to the value for the given key in a single descent. A missing
+ * key starts at 0.
+ * @param tree
+ * @param key
+ * @param amount
+ * @return The updated value.
+ */
+int artIncrement(ArtTree* tree, const char* key, int amount)
+{
+    int isNew = 0;
+    int* slot = insert(&tree->root, (const unsigned char*)key,
+                       (int)strlen(key) + 1, 0, 0, &isNew);
+    *slot += amount;
+    tree->size += isNew;
+    return *slot;
+}
+
+/**
+ * Returns 1 if the key is in the tree and 0 otherwise.
+ * @param tree
+ * @param key
+ * @return 1 if the key is found, 0 otherwise.
+ */
+int artContainsKey(ArtTree* tree, const char* key)
+{
+    return artGet(tree, key) != NULL;
+}
+
+/**
+ * Returns the number of keys in the tree.
+ * @param tree
+ * @return Number of keys.
+ */
+int artSize(ArtTree* tree)
+{
+    return tree->size;
+}
+
+/**
+ * Calls visit on every key and value in the tree in byte-wise key order.
+ * @param tree
+ * @param visit
+ * @param context Passed through to visit.
+ */
+void artForEach(ArtTree* tree, ArtVisitFunction visit, void* context)
+{
+    visitAll(tree->root, visit, context);
+}
+
+/**
+ * Calls visit, in key order, on every key that starts with the given prefix.
+ * @param tree
+ * @param prefix
+ * @param visit
+ * @param context Passed through to visit.
+ * @return Number of keys visited.
+ */
+int artPrefixScan(ArtTree* tree, const char* prefix, ArtVisitFunction visit,
+                  void* context)
+{
+    const unsigned char* p = (const unsigned char*)prefix;
+    int prefixLength = (int)strlen(prefix);
+    void* node = tree->root;
+    int depth = 0;
+    while (node != NULL)
+    {
+        if (IS_LEAF(node))
+        {
+            ArtLeaf* leaf = LEAF_RAW(node);
+            if (strncmp(leaf->key, prefix, prefixLength) == 0)
+            {
+                visit(leaf->key, leaf->value, context);
+                return 1;
+            }
+            return 0;
+        }
+        if (depth == prefixLength)
+        {
+            break;
+        }
+        ArtNode* n = node;
+        if (n->prefixLength)
+        {
+            int match = prefixMismatch(n, p, prefixLength, depth);
+            if (depth + match == prefixLength)
+            {
+                break;
+            }
+            if (match < n->prefixLength)
+            {
+                return 0;
+            }
+            depth += n->prefixLength;
+        }
+        void** child = findChild(n, p[depth]);
+        node = child ? *child : NULL;
+        depth++;
+    }
+    if (node == NULL)
+    {
+        return 0;
+    }
+    
+    /* Every key below node starts with the prefix. */
+    return visitAll(node, visit, context);
+}
+
+static void printEntry(const char* key, int value, void* context)
+{
+    (void)context;
+    printf(" (%s, %d)", key, value);
+}
+
+/**
+ * Prints all the keys and values in the tree in key order.
+ * @param tree
+ */
+void artPrint(ArtTree* tree)
+{
+    artForEach(tree, printEntry, NULL);
+    printf("\n");
+}
@@ -0,0 +1,31 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Adaptive radix tree map from strings to ints.
+ */
+
+#ifndef ART_H
+#define ART_H
+
+typedef struct ArtTree ArtTree;
+
+/**
+ * Called for each key in artForEach and artPrefixScan, in key order.
+ */
+typedef void (*ArtVisitFunction)(const char* key, int value, void* context);
+
+ArtTree* artNew(void);
+void artDelete(ArtTree* tree);
+
+int* artGet(ArtTree* tree, const char* key);
+void artPut(ArtTree* tree, const char* key, int value);
+int artIncrement(ArtTree* tree, const char* key, int amount);
+int artContainsKey(ArtTree* tree, const char* key);
+int artSize(ArtTree* tree);
+
+void artForEach(ArtTree* tree, ArtVisitFunction visit, void* context);
+int artPrefixScan(ArtTree* tree, const char* prefix, ArtVisitFunction visit,
+                  void* context);
+void artPrint(ArtTree* tree);
+
+#endif
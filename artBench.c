@@ -0,0 +1,161 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Benchmark comparing the adaptive radix tree with the hash map on the
+ * concordance workload.
+ */
+
+#include "art.h"
+#include "hashMap.h"
+#include "tokenizer.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+/**
+ * Reads every word of the file with the concordance's tokenizer, so both
+ * programs see the same keys, into one buffer of '\0' separated words.
+ * @param file
+ * @param numWords Set to the number of words read.
+ * @return Allocated buffer of words.
+ */
+static char* readWords(FILE* file, int* numWords)
+{
+    size_t capacity = 1 << 16;
+    size_t length = 0;
+    char* words = malloc(capacity);
+    assert(words != 0);
+    *numWords = 0;
+    
+    Tokenizer* tokenizer = tokenizerNew(file, 0);
+    char* word;
+    while ((word = tokenizerNext(tokenizer)) != NULL)
+    {
+        size_t size = strlen(word) + 1;
+        if (length + size + 1 > capacity)
+        {
+            while (length + size + 1 > capacity)
+            {
+                capacity *= 2;
+            }
+            words = realloc(words, capacity);
+            assert(words != 0);
+        }
+        memcpy(words + length, word, size);
+        length += size;
+        ++(*numWords);
+        free(word);
+    }
+    tokenizerDelete(tokenizer);
+    words[length] = '\0';
+    return words;
+}
+
+static float seconds(clock_t timer)
+{
+    return (float)timer / (float)CLOCKS_PER_SEC;
+}
+
+static void countPrefix(const char* key, int value, void* context)
+{
+    (void)key;
+    (void)value;
+    ++(*(int*)context);
+}
+
+/**
+ * Counts the words of the given file with both the hash map and the adaptive
+ * radix tree, then looks every word up again, and prints the time taken by
+ * each phase. An optional second argument is a prefix to scan in the tree.
+ * @param argc
+ * @param argv
+ * @return
+ */
+int main(int argc, const char** argv)
+{
+    const char* fileName = "input3.txt";
+    if (argc > 1)
+    {
+        fileName = argv[1];
+    }
+    FILE* file = fopen(fileName, "r");
+    if (file == NULL)
+    {
+        printf("File does not exist.\n");
+        return 1;
+    }
+    int numWords;
+    char* words = readWords(file, &numWords);
+    fclose(file);
+    printf("Words: %d\n", numWords);
+    
+    /* Hash map, counted the way main.c does it. */
+    clock_t timer = clock();
+    HashMap* map = hashMapNew(10);
+    char* word = words;
+    for (int i = 0; i < numWords; i++)
+    {
+        if (hashMapContainsKey(map, word))
+        {
+            hashMapPut(map, word, *hashMapGet(map, word) + 1);
+        }
+        else
+        {
+            hashMapPut(map, word, 1);
+        }
+        word += strlen(word) + 1;
+    }
+    printf("HashMap insert: %f seconds\n", seconds(clock() - timer));
+    
+    timer = clock();
+    long total = 0;
+    word = words;
+    for (int i = 0; i < numWords; i++)
+    {
+        total += *hashMapGet(map, word);
+        word += strlen(word) + 1;
+    }
+    printf("HashMap lookup: %f seconds (checksum %ld)\n",
+           seconds(clock() - timer), total);
+    
+    /* Adaptive radix tree. */
+    timer = clock();
+    ArtTree* tree = artNew();
+    word = words;
+    for (int i = 0; i < numWords; i++)
+    {
+        artIncrement(tree, word, 1);
+        word += strlen(word) + 1;
+    }
+    printf("ART insert: %f seconds\n", seconds(clock() - timer));
+    
+    timer = clock();
+    total = 0;
+    word = words;
+    for (int i = 0; i < numWords; i++)
+    {
+        total += *artGet(tree, word);
+        word += strlen(word) + 1;
+    }
+    printf("ART lookup: %f seconds (checksum %ld)\n",
+           seconds(clock() - timer), total);
+    
+    if (argc > 2)
+    {
+        int matches = 0;
+        timer = clock();
+        artPrefixScan(tree, argv[2], countPrefix, &matches);
+        printf("ART prefix \"%s\": %d keys in %f seconds\n", argv[2], matches,
+               seconds(clock() - timer));
+    }
+    
+    printf("Distinct words: %d (HashMap) %d (ART)\n", hashMapSize(map),
+           artSize(tree));
+    
+    artDelete(tree);
+    hashMapDelete(map);
+    free(words);
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Checkpoint implementation file.
+ *
+ * A checkpoint records how far into the input the concordance has read and
+ * the word counts up to that point:
+ *
+ *     magic | version | foldCase | numWords | offset |
+ *     numWords x (value, keyLength, key bytes)
+ *
+ * Integers are stored in the host's byte order, since a checkpoint is only
+ * read back by the same program on the same machine.
+ */
+
+#include "checkpoint.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#define CHECKPOINT_MAGIC 0x54504b43u /* "CKPT" */
+#define CHECKPOINT_VERSION 1u
+
+typedef struct CheckpointHeader CheckpointHeader;
+
+struct CheckpointHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t foldCase;
+    uint32_t numWords;
+    int64_t offset;
+};
+
+/**
+ * Writes the map and input offset to the checkpoint file. The checkpoint is
+ * written to a temporary file first and renamed over the old one, so an
+ * interrupted save leaves the previous checkpoint intact.
+ * @param fileName
+ * @param map
+ * @param offset Input offset up to which words have been counted.
+ * @param foldCase 1 if the words were case folded.
+ * @return 1 on success, 0 otherwise.
+ */
+int checkpointSave(const char* fileName, HashMap* map, long offset,
+                   int foldCase)
+{
+    char* tempName = malloc(strlen(fileName) + 5);
+    assert(tempName != 0);
+    strcpy(tempName, fileName);
+    strcat(tempName, ".tmp");
+    
+    FILE* file = fopen(tempName, "wb");
+    if (file == NULL)
+    {
+        free(tempName);
+        return 0;
+    }
+    
+    CheckpointHeader header;
+    header.magic = CHECKPOINT_MAGIC;
+    header.version = CHECKPOINT_VERSION;
+    header.foldCase = (uint32_t)foldCase;
+    header.numWords = (uint32_t)hashMapSize(map);
+    header.offset = offset;
+    int ok = fwrite(&header, sizeof header, 1, file) == 1;
+    
+    for (int i = 0; ok && i < map->capacity; i++)
+    {
+        for (HashLink* link = map->table[i]; ok && link != NULL;
+             link = link->next)
+        {
+            int32_t value = link->value;
+            uint32_t keyLength = (uint32_t)strlen(link->key);
+            ok = fwrite(&value, sizeof value, 1, file) == 1
+                && fwrite(&keyLength, sizeof keyLength, 1, file) == 1
+                && fwrite(link->key, 1, keyLength, file) == keyLength;
+        }
+    }
+    
+    ok = (fclose(file) == 0) && ok;
+    ok = ok && rename(tempName, fileName) == 0;
+    if (!ok)
+    {
+        remove(tempName);
+    }
+    free(tempName);
+    return ok;
+}
+
+/**
+ * Reads a checkpoint written by checkpointSave.
+ * @param fileName
+ * @param offset Set to the input offset stored in the checkpoint.
+ * @param foldCase Set to 1 if the stored words were case folded.
+ * @return The restored map, or NULL if the file is missing or invalid.
+ */
+HashMap* checkpointLoad(const char* fileName, long* offset, int* foldCase)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    
+    /* Every length read from the file is checked against the bytes left in
+     * it, so a corrupt checkpoint cannot size a table or key buffer. */
+    long fileSize = -1;
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        fileSize = ftell(file);
+    }
+    CheckpointHeader header;
+    if (fileSize < (long)sizeof header || fseek(file, 0, SEEK_SET) != 0
+        || fread(&header, sizeof header, 1, file) != 1
+        || header.magic != CHECKPOINT_MAGIC
+        || header.version != CHECKPOINT_VERSION
+        || header.numWords > INT_MAX)
+    {
+        fclose(file);
+        return NULL;
+    }
+    
+    /* Each word takes at least its value and key length. */
+    long remaining = fileSize - (long)sizeof header;
+    if ((long)header.numWords > remaining / 8)
+    {
+        fclose(file);
+        return NULL;
+    }
+    
+    /* Size the table for the stored words so loading never resizes. */
+    int capacity = header.numWords > 10 ? (int)header.numWords : 10;
+    HashMap* map = hashMapNew(capacity);
+    int keyCapacity = 64;
+    char* key = malloc(keyCapacity);
+    assert(key != 0);
+    int ok = 1;
+    for (uint32_t i = 0; ok && i < header.numWords; i++)
+    {
+        int32_t value;
+        uint32_t keyLength;
+        ok = fread(&value, sizeof value, 1, file) == 1
+            && fread(&keyLength, sizeof keyLength, 1, file) == 1;
+        ok = ok && keyLength < INT_MAX
+            && (long)keyLength <= remaining - 8;
+        if (ok && (int)keyLength + 1 > keyCapacity)
+        {
+            keyCapacity = (int)keyLength + 1;
+            key = realloc(key, keyCapacity);
+            assert(key != 0);
+        }
+        ok = ok && fread(key, 1, keyLength, file) == keyLength;
+        if (ok)
+        {
+            key[keyLength] = '\0';
+            hashMapPut(map, key, value);
+            remaining -= 8 + (long)keyLength;
+        }
+    }
+    free(key);
+    fclose(file);
+    
+    if (!ok)
+    {
+        hashMapDelete(map);
+        return NULL;
+    }
+    *offset = (long)header.offset;
+    *foldCase = (int)header.foldCase;
+    return map;
+}
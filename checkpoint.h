@@ -0,0 +1,16 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Concordance checkpoints for resuming over append-only files.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "hashMap.h"
+
+int checkpointSave(const char* fileName, HashMap* map, long offset,
+                   int foldCase);
+HashMap* checkpointLoad(const char* fileName, long* offset, int* foldCase);
+
+#endif
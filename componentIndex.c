@@ -0,0 +1,168 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * ComponentIndex implementation file.
+ *
+ * The graphs are undirected, so a vertex is reachable from another exactly
+ * when both are in the same connected component. The index labels the
+ * components once, in near linear time, after which a reachability query
+ * is two finds and a comparison instead of a traversal.
+ */
+
+#include "componentIndex.h"
+#include <stdlib.h>
+#include <assert.h>
+
+/**
+ * Returns the root of the vertex's tree, halving the path to it on the way
+ * so later finds are shorter. Writes to the forest, so only unions and the
+ * build use it.
+ * @param index
+ * @param vertex
+ * @return The component label.
+ */
+static int findCompress(ComponentIndex* index, int vertex)
+{
+    assert(vertex >= 0 && vertex < index->numVertices);
+    int* parent = index->parent;
+    while (parent[vertex] != vertex)
+    {
+        parent[vertex] = parent[parent[vertex]];
+        vertex = parent[vertex];
+    }
+    return vertex;
+}
+
+/**
+ * Builds the component index of the graph. The graph is not modified.
+ * @param graph
+ * @return The index.
+ */
+ComponentIndex* componentIndexNew(Graph* graph)
+{
+    ComponentIndex* index = malloc(sizeof(ComponentIndex));
+    assert(index != 0);
+    int numVertices = graph->numVertices;
+    index->parent = malloc(sizeof(int) * numVertices);
+    index->size = malloc(sizeof(int) * numVertices);
+    assert(index->parent != 0 && index->size != 0);
+    index->numVertices = numVertices;
+    index->numComponents = numVertices;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        index->parent[i] = i;
+        index->size[i] = 1;
+    }
+
+    /* Each edge is in both endpoints' lists; union it once. */
+    for (int i = 0; i < numVertices; ++i)
+    {
+        Vertex* vertex = &graph->vertexSet[i];
+        for (int j = 0; j < vertex->numNeighbors; ++j)
+        {
+            int neighbor = (int)(vertex->neighbors[j] - graph->vertexSet);
+            if (neighbor > i)
+            {
+                componentIndexUnion(index, i, neighbor);
+            }
+        }
+    }
+
+    /* Point every vertex straight at its root, so queries take one step. */
+    for (int i = 0; i < numVertices; ++i)
+    {
+        index->parent[i] = findCompress(index, i);
+    }
+    return index;
+}
+
+/**
+ * Frees the index.
+ * @param index
+ */
+void componentIndexDelete(ComponentIndex* index)
+{
+    free(index->parent);
+    free(index->size);
+    free(index);
+}
+
+/**
+ * Returns the label of the vertex's component, the index of its root. Only
+ * reads the index, so concurrent queries are safe. Trees are flattened when
+ * the index is built and kept shallow by union by size, so the walk is short.
+ * @param index
+ * @param vertex
+ * @return The component label.
+ */
+int componentIndexFind(ComponentIndex* index, int vertex)
+{
+    assert(vertex >= 0 && vertex < index->numVertices);
+    const int* parent = index->parent;
+    while (parent[vertex] != vertex)
+    {
+        vertex = parent[vertex];
+    }
+    return vertex;
+}
+
+/**
+ * Merges the components of u and v, hanging the smaller tree under the
+ * larger one to keep the trees shallow.
+ * @param index
+ * @param u
+ * @param v
+ * @return 1 if two components were merged, 0 if already the same.
+ */
+int componentIndexUnion(ComponentIndex* index, int u, int v)
+{
+    int a = findCompress(index, u);
+    int b = findCompress(index, v);
+    if (a == b)
+    {
+        return 0;
+    }
+    if (index->size[a] < index->size[b])
+    {
+        int temp = a;
+        a = b;
+        b = temp;
+    }
+    index->parent[b] = a;
+    index->size[a] += index->size[b];
+    --(index->numComponents);
+    return 1;
+}
+
+/**
+ * Determines if there is a path between u and v.
+ * @param index
+ * @param u
+ * @param v
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int componentIndexConnected(ComponentIndex* index, int u, int v)
+{
+    return componentIndexFind(index, u) == componentIndexFind(index, v);
+}
+
+/**
+ * Returns the number of connected components.
+ * @param index
+ * @return The number of components.
+ */
+int componentIndexCount(ComponentIndex* index)
+{
+    return index->numComponents;
+}
+
+/**
+ * Returns the number of vertices in the vertex's component.
+ * @param index
+ * @param vertex
+ * @return The component size.
+ */
+int componentIndexSize(ComponentIndex* index, int vertex)
+{
+    return index->size[componentIndexFind(index, vertex)];
+}
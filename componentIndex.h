@@ -0,0 +1,36 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Connected component index for constant time reachability queries.
+ */
+
+#ifndef COMPONENT_INDEX_H
+#define COMPONENT_INDEX_H
+
+#include "graph.h"
+
+typedef struct ComponentIndex ComponentIndex;
+
+/**
+ * Union-find forest over vertex indices. The root of a vertex's tree labels
+ * its component. size[r] is the number of vertices under root r. Queries
+ * only read the forest, so any number may run at once, but not while a
+ * union is running.
+ */
+struct ComponentIndex
+{
+    int* parent;
+    int* size;
+    int numVertices;
+    int numComponents;
+};
+
+ComponentIndex* componentIndexNew(Graph* graph);
+void componentIndexDelete(ComponentIndex* index);
+int componentIndexFind(ComponentIndex* index, int vertex);
+int componentIndexUnion(ComponentIndex* index, int u, int v);
+int componentIndexConnected(ComponentIndex* index, int u, int v);
+int componentIndexCount(ComponentIndex* index);
+int componentIndexSize(ComponentIndex* index, int vertex);
+
+#endif
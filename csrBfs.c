@@ -0,0 +1,809 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * CsrGraph breadth-first search implementation file.
+ *
+ * A top-down BFS step checks every edge out of the frontier, even though in
+ * the middle levels of a low-diameter graph almost all of them lead to
+ * vertices that are already visited. A bottom-up step instead has each
+ * unvisited vertex look through its neighbors for one in the frontier and
+ * stop at the first hit, which checks far fewer edges once the frontier is
+ * large. The direction-optimizing search picks the cheaper step per level,
+ * using the heuristic from Beamer, Asanovic and Patterson.
+ *
+ * Many searches over one graph repeat the same adjacency scans. The
+ * multi-source search runs up to MAX_LANES of them at once, as in MS-BFS by
+ * Then et al.: each vertex holds one bit per search for seen and for in the
+ * frontier, and one scan of a neighbor list advances every search whose
+ * frontier holds that vertex with a few word-wide ORs.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "csrBfs.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+/* Go bottom-up once frontier edges exceed unvisited edges / ALPHA. */
+#define ALPHA 15
+/* Go back top-down once the frontier has fewer than vertices / BETA. */
+#define BETA 18
+
+/* Frontier vertices a thread claims at a time in the parallel search. */
+#define FRONTIER_CHUNK 64
+
+#define BITMAP_WORDS(n) (((n) + 63) / 64)
+
+/* Searches per multi-source run: 64 per word, at most MAX_LANE_WORDS words
+ * per vertex. */
+#define MAX_LANE_WORDS 4
+#define MAX_LANES (64 * MAX_LANE_WORDS)
+
+static inline int bitmapGet(const uint64_t* bitmap, uint32_t i)
+{
+    return (bitmap[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void bitmapSet(uint64_t* bitmap, uint32_t i)
+{
+    bitmap[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+/**
+ * Returns the degree of a vertex.
+ * @param graph
+ * @param vertex
+ * @return The number of neighbors.
+ */
+static inline uint64_t degree(CsrGraph* graph, uint32_t vertex)
+{
+    return graph->offsets[vertex + 1] - graph->offsets[vertex];
+}
+
+/**
+ * Visits every vertex reachable from the source in breadth-first order,
+ * recording each vertex's parent in the BFS tree. Expands the frontier
+ * top-down at every level.
+ * @param graph
+ * @param source Index of the source vertex.
+ * @param parents Array of numVertices entries. Set to the parent of each
+ *        reached vertex, the source itself for the source and -1 for
+ *        vertices not reachable from the source.
+ * @return The number of vertices reached, including the source.
+ */
+int csrBfsTopDown(CsrGraph* graph, int source, int* parents)
+{
+    assert(source >= 0 && source < graph->numVertices);
+    uint32_t* queue = malloc(sizeof(uint32_t) * graph->numVertices);
+    assert(queue != 0);
+    for (int i = 0; i < graph->numVertices; ++i)
+    {
+        parents[i] = -1;
+    }
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = (uint32_t)source;
+    parents[source] = source;
+    while (head < tail)
+    {
+        uint32_t cur = queue[head++];
+        for (uint64_t i = graph->offsets[cur]; i < graph->offsets[cur + 1];
+             ++i)
+        {
+            uint32_t neighbor = graph->neighbors[i];
+            if (parents[neighbor] < 0)
+            {
+                parents[neighbor] = (int)cur;
+                queue[tail++] = neighbor;
+            }
+        }
+    }
+    free(queue);
+    return tail;
+}
+
+/**
+ * Top-down step. Expands the frontier queue[begin, end) and appends the
+ * next level to the queue.
+ * @param graph
+ * @param parents
+ * @param queue
+ * @param begin
+ * @param end
+ * @param edges Set to the number of edges out of the next level.
+ * @return The new end of the queue.
+ */
+static int topDownStep(CsrGraph* graph, int* parents, uint32_t* queue,
+                       int begin, int end, uint64_t* edges)
+{
+    int tail = end;
+    uint64_t nextEdges = 0;
+    for (int q = begin; q < end; ++q)
+    {
+        uint32_t cur = queue[q];
+        for (uint64_t i = graph->offsets[cur]; i < graph->offsets[cur + 1];
+             ++i)
+        {
+            uint32_t neighbor = graph->neighbors[i];
+            if (parents[neighbor] < 0)
+            {
+                parents[neighbor] = (int)cur;
+                queue[tail++] = neighbor;
+                nextEdges += degree(graph, neighbor);
+            }
+        }
+    }
+    *edges = nextEdges;
+    return tail;
+}
+
+/**
+ * Bottom-up step. Every unvisited vertex looks for a neighbor in the
+ * frontier bitmap and, on the first one found, joins the next frontier.
+ * @param graph
+ * @param parents
+ * @param frontier Bitmap of the current level.
+ * @param next Bitmap of the next level, zeroed on entry.
+ * @param edges Set to the number of edges out of the next level.
+ * @return The number of vertices in the next level.
+ */
+static int bottomUpStep(CsrGraph* graph, int* parents,
+                        const uint64_t* frontier, uint64_t* next,
+                        uint64_t* edges)
+{
+    int count = 0;
+    uint64_t nextEdges = 0;
+    for (uint32_t v = 0; v < (uint32_t)graph->numVertices; ++v)
+    {
+        if (parents[v] >= 0)
+        {
+            continue;
+        }
+        for (uint64_t i = graph->offsets[v]; i < graph->offsets[v + 1]; ++i)
+        {
+            uint32_t neighbor = graph->neighbors[i];
+            if (bitmapGet(frontier, neighbor))
+            {
+                parents[v] = (int)neighbor;
+                bitmapSet(next, v);
+                ++count;
+                nextEdges += degree(graph, v);
+                break;
+            }
+        }
+    }
+    *edges = nextEdges;
+    return count;
+}
+
+/**
+ * Same as csrBfsTopDown, but switches each level between top-down and
+ * bottom-up expansion. It goes bottom-up when the edges out of the frontier
+ * exceed 1/ALPHA of the edges out of unvisited vertices, and back top-down
+ * when the frontier shrinks below 1/BETA of the vertices. On low-diameter
+ * graphs this examines several times fewer edges. The parent found for a
+ * vertex may differ from csrBfsTopDown's, but has the same BFS depth.
+ * @param graph
+ * @param source Index of the source vertex.
+ * @param parents Array of numVertices entries, set as in csrBfsTopDown.
+ * @return The number of vertices reached, including the source.
+ */
+int csrBfsDirectionOptimizing(CsrGraph* graph, int source, int* parents)
+{
+    assert(source >= 0 && source < graph->numVertices);
+    int numVertices = graph->numVertices;
+    int words = BITMAP_WORDS(numVertices);
+    uint32_t* queue = malloc(sizeof(uint32_t) * numVertices);
+    uint64_t* frontier = malloc(sizeof(uint64_t) * words);
+    uint64_t* next = malloc(sizeof(uint64_t) * words);
+    assert(queue != 0 && frontier != 0 && next != 0);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        parents[i] = -1;
+    }
+
+    /* The frontier is queue[begin, end) while top-down and the frontier
+     * bitmap while bottom-up. */
+    int begin = 0;
+    int end = 0;
+    queue[end++] = (uint32_t)source;
+    parents[source] = source;
+    int frontierSize = 1;
+    int reached = 1;
+    uint64_t frontierEdges = degree(graph, source);
+    uint64_t unvisitedEdges = graph->offsets[numVertices] - frontierEdges;
+    int bottomUp = 0;
+
+    while (frontierSize > 0)
+    {
+        if (!bottomUp && frontierEdges > unvisitedEdges / ALPHA)
+        {
+            /* Switch to bottom-up: move the frontier into the bitmap. */
+            memset(frontier, 0, sizeof(uint64_t) * words);
+            for (int q = begin; q < end; ++q)
+            {
+                bitmapSet(frontier, queue[q]);
+            }
+            bottomUp = 1;
+        }
+        else if (bottomUp && frontierSize < numVertices / BETA)
+        {
+            /* Switch to top-down: move the frontier into the queue. */
+            begin = end = 0;
+            for (int w = 0; w < words; ++w)
+            {
+                uint64_t bits = frontier[w];
+                while (bits != 0)
+                {
+                    queue[end++] = (uint32_t)(w * 64 + __builtin_ctzll(bits));
+                    bits &= bits - 1;
+                }
+            }
+            bottomUp = 0;
+        }
+
+        if (bottomUp)
+        {
+            memset(next, 0, sizeof(uint64_t) * words);
+            frontierSize = bottomUpStep(graph, parents, frontier, next,
+                                        &frontierEdges);
+            uint64_t* temp = frontier;
+            frontier = next;
+            next = temp;
+        }
+        else
+        {
+            /* The queue never holds a vertex twice, so restarting it at 0
+             * after a bottom-up phase cannot overflow. */
+            int tail = topDownStep(graph, parents, queue, begin, end,
+                                   &frontierEdges);
+            begin = end;
+            end = tail;
+            frontierSize = end - begin;
+        }
+        reached += frontierSize;
+        unvisitedEdges -= frontierEdges;
+    }
+    free(queue);
+    free(frontier);
+    free(next);
+    return reached;
+}
+
+typedef struct ParallelBfs ParallelBfs;
+typedef struct BfsWorker BfsWorker;
+
+/**
+ * State shared by the threads of one parallel search. The frontier of the
+ * current level is frontier[0, frontierSize); threads claim chunks of it
+ * through cursor.
+ */
+struct ParallelBfs
+{
+    CsrGraph* graph;
+    int source;
+    int* distances;
+    int* parents;
+    uint32_t* frontier;
+    uint32_t* next;
+    int frontierSize;
+    int cursor;
+    int level;
+    int reached;
+    int numThreads;
+    BfsWorker* workers;
+    pthread_barrier_t barrier;
+    pthread_mutex_t startLock;
+    pthread_cond_t startSignal;
+    int start;
+};
+
+/**
+ * A thread's share of the search. Vertices it claims for the next level go
+ * to its own buffer first and are copied into the shared next frontier at
+ * offset once every thread is done with the level.
+ */
+struct BfsWorker
+{
+    ParallelBfs* bfs;
+    int id;
+    uint32_t* local;
+    int localSize;
+    int localCapacity;
+};
+
+/**
+ * Appends a vertex to the worker's buffer, doubling it when full.
+ * @param worker
+ * @param vertex
+ */
+static void workerPush(BfsWorker* worker, uint32_t vertex)
+{
+    if (worker->localSize == worker->localCapacity)
+    {
+        worker->localCapacity *= 2;
+        worker->local = realloc(worker->local,
+                                sizeof(uint32_t) * worker->localCapacity);
+        assert(worker->local != 0);
+    }
+    worker->local[worker->localSize++] = vertex;
+}
+
+/**
+ * Returns 1 for exactly one of the threads waiting at the barrier.
+ * @param bfs
+ * @return 1 for the serial thread, 0 otherwise.
+ */
+static int barrierWait(ParallelBfs* bfs)
+{
+    if (bfs->numThreads == 1)
+    {
+        return 1;
+    }
+    return pthread_barrier_wait(&bfs->barrier) ==
+           PTHREAD_BARRIER_SERIAL_THREAD;
+}
+
+/**
+ * Blocks until the calling thread has started every worker, or failed to.
+ * @param bfs
+ * @return 1 if the search is going ahead, 0 if the worker should exit.
+ */
+static int waitForStart(ParallelBfs* bfs)
+{
+    pthread_mutex_lock(&bfs->startLock);
+    while (bfs->start < 0)
+    {
+        pthread_cond_wait(&bfs->startSignal, &bfs->startLock);
+    }
+    int start = bfs->start;
+    pthread_mutex_unlock(&bfs->startLock);
+    return start;
+}
+
+/**
+ * Lets the started workers run the search, or tells them to exit.
+ * @param bfs
+ * @param start 1 to run, 0 to exit.
+ */
+static void releaseWorkers(ParallelBfs* bfs, int start)
+{
+    pthread_mutex_lock(&bfs->startLock);
+    bfs->start = start;
+    pthread_cond_broadcast(&bfs->startSignal);
+    pthread_mutex_unlock(&bfs->startLock);
+}
+
+/**
+ * Worker thread. Runs every level of the search in lockstep with the other
+ * workers, separated by barriers.
+ * @param arg The BfsWorker.
+ * @return NULL
+ */
+static void* bfsWorkerRun(void* arg)
+{
+    BfsWorker* worker = arg;
+    ParallelBfs* bfs = worker->bfs;
+    if (worker->id > 0 && !waitForStart(bfs))
+    {
+        return NULL;
+    }
+    CsrGraph* graph = bfs->graph;
+    int* parents = bfs->parents;
+    int* distances = bfs->distances;
+    
+    /* Each thread clears its slice of the output arrays. */
+    int numVertices = graph->numVertices;
+    int begin = (int)((long)numVertices * worker->id / bfs->numThreads);
+    int end = (int)((long)numVertices * (worker->id + 1) / bfs->numThreads);
+    for (int i = begin; i < end; ++i)
+    {
+        parents[i] = -1;
+        if (distances != NULL)
+        {
+            distances[i] = -1;
+        }
+    }
+    if (barrierWait(bfs))
+    {
+        parents[bfs->source] = bfs->source;
+        if (distances != NULL)
+        {
+            distances[bfs->source] = 0;
+        }
+    }
+    barrierWait(bfs);
+    
+    while (bfs->frontierSize > 0)
+    {
+        /* Expand chunks of the frontier. A vertex belongs to whichever
+         * thread first swaps its parent from -1. */
+        int level = bfs->level + 1;
+        while ((begin = __sync_fetch_and_add(&bfs->cursor, FRONTIER_CHUNK))
+               < bfs->frontierSize)
+        {
+            end = begin + FRONTIER_CHUNK;
+            if (end > bfs->frontierSize)
+            {
+                end = bfs->frontierSize;
+            }
+            for (int q = begin; q < end; ++q)
+            {
+                uint32_t cur = bfs->frontier[q];
+                for (uint64_t i = graph->offsets[cur];
+                     i < graph->offsets[cur + 1]; ++i)
+                {
+                    uint32_t neighbor = graph->neighbors[i];
+                    if (__atomic_load_n(&parents[neighbor],
+                                        __ATOMIC_RELAXED) < 0 &&
+                        __sync_bool_compare_and_swap(&parents[neighbor], -1,
+                                                     (int)cur))
+                    {
+                        if (distances != NULL)
+                        {
+                            distances[neighbor] = level;
+                        }
+                        workerPush(worker, neighbor);
+                    }
+                }
+            }
+        }
+        barrierWait(bfs);
+        
+        /* Concatenate the buffers, in thread order, into the next level. */
+        int offset = 0;
+        for (int t = 0; t < worker->id; ++t)
+        {
+            offset += bfs->workers[t].localSize;
+        }
+        memcpy(bfs->next + offset, worker->local,
+               sizeof(uint32_t) * worker->localSize);
+        if (barrierWait(bfs))
+        {
+            int size = 0;
+            for (int t = 0; t < bfs->numThreads; ++t)
+            {
+                size += bfs->workers[t].localSize;
+                bfs->workers[t].localSize = 0;
+            }
+            uint32_t* temp = bfs->frontier;
+            bfs->frontier = bfs->next;
+            bfs->next = temp;
+            bfs->frontierSize = size;
+            bfs->reached += size;
+            bfs->cursor = 0;
+            bfs->level = level;
+        }
+        barrierWait(bfs);
+    }
+    return NULL;
+}
+
+/**
+ * Same as csrBfsTopDown, but expands each level of the search on numThreads
+ * threads. Threads take chunks of the frontier, claim unvisited neighbors
+ * with a compare-and-swap on their parent entry and collect them in
+ * per-thread buffers, which are concatenated into the next frontier after
+ * the level. Each vertex gets a parent at the right depth, but which one
+ * depends on thread timing. If the threads cannot all be started, the
+ * search runs with as many as could be.
+ * @param graph
+ * @param source Index of the source vertex.
+ * @param distances Array of numVertices entries, or NULL. Set to the number
+ *        of edges on a shortest path from the source, or -1 if unreachable.
+ * @param parents Array of numVertices entries, set as in csrBfsTopDown.
+ * @param numThreads Number of worker threads, at least 1.
+ * @return The number of vertices reached, including the source.
+ */
+int csrBfsParallel(CsrGraph* graph, int source, int* distances, int* parents,
+                   int numThreads)
+{
+    assert(source >= 0 && source < graph->numVertices);
+    assert(parents != 0);
+    assert(numThreads > 0);
+    
+    ParallelBfs bfs;
+    bfs.graph = graph;
+    bfs.source = source;
+    bfs.distances = distances;
+    bfs.parents = parents;
+    bfs.frontier = malloc(sizeof(uint32_t) * graph->numVertices);
+    bfs.next = malloc(sizeof(uint32_t) * graph->numVertices);
+    assert(bfs.frontier != 0 && bfs.next != 0);
+    bfs.frontier[0] = (uint32_t)source;
+    bfs.frontierSize = 1;
+    bfs.cursor = 0;
+    bfs.level = 0;
+    bfs.reached = 1;
+    bfs.numThreads = numThreads;
+    bfs.workers = malloc(sizeof(BfsWorker) * numThreads);
+    pthread_t* threads = malloc(sizeof(pthread_t) * numThreads);
+    assert(bfs.workers != 0 && threads != 0);
+    if (numThreads > 1 &&
+        pthread_barrier_init(&bfs.barrier, NULL, numThreads) != 0)
+    {
+        bfs.numThreads = numThreads = 1;
+    }
+    pthread_mutex_init(&bfs.startLock, NULL);
+    pthread_cond_init(&bfs.startSignal, NULL);
+    bfs.start = -1;
+    
+    for (int t = 0; t < numThreads; t++)
+    {
+        BfsWorker* worker = &bfs.workers[t];
+        worker->bfs = &bfs;
+        worker->id = t;
+        worker->localSize = 0;
+        worker->localCapacity = 1024;
+        worker->local = malloc(sizeof(uint32_t) * worker->localCapacity);
+        assert(worker->local != 0);
+    }
+    
+    /* Workers wait until all have started, since the barrier counts on
+     * every one of them. */
+    int started = 1;
+    while (started < numThreads &&
+           pthread_create(&threads[started], NULL, bfsWorkerRun,
+                          &bfs.workers[started]) == 0)
+    {
+        ++started;
+    }
+    releaseWorkers(&bfs, started == numThreads);
+    if (started == numThreads)
+    {
+        bfsWorkerRun(&bfs.workers[0]);
+    }
+    for (int t = 1; t < started; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    
+    if (numThreads > 1)
+    {
+        pthread_barrier_destroy(&bfs.barrier);
+    }
+    pthread_mutex_destroy(&bfs.startLock);
+    pthread_cond_destroy(&bfs.startSignal);
+    for (int t = 0; t < numThreads; t++)
+    {
+        free(bfs.workers[t].local);
+    }
+    free(bfs.workers);
+    free(threads);
+    free(bfs.frontier);
+    free(bfs.next);
+    if (started < numThreads)
+    {
+        return csrBfsParallel(graph, source, distances, parents, started);
+    }
+    return bfs.reached;
+}
+
+/**
+ * Body of csrBfsMultiSource for a fixed number of lane words. Always
+ * inlined with a constant words, so the word loops are unrolled or
+ * vectorized. Only frontier vertices are expanded at each level.
+ *
+ * Pushing to a neighbor reads its seen lanes and writes its next lanes, so
+ * both live side by side in lanes, words of each per vertex: with four
+ * words, one 64-byte cache line per neighbor.
+ * @param graph
+ * @param sources
+ * @param numSources
+ * @param seen Array of numVertices * words words, filled in here.
+ * @param distances As in csrBfsMultiSource.
+ * @param words (numSources + 63) / 64.
+ * @return As in csrBfsMultiSource.
+ */
+static inline __attribute__((always_inline))
+int multiSourceRun(CsrGraph* graph, const int* sources, int numSources,
+                   uint64_t* seen, int* distances, int words)
+{
+    int numVertices = graph->numVertices;
+    size_t stride = 2 * (size_t)words;
+    uint64_t* lanes = calloc((size_t)numVertices * stride + 1,
+                             sizeof(uint64_t));
+    uint64_t* visit = calloc((size_t)numVertices * words + 1,
+                             sizeof(uint64_t));
+    uint32_t* frontier = malloc(sizeof(uint32_t) * (numVertices + 1));
+    uint32_t* touched = malloc(sizeof(uint32_t) * (numVertices + 1));
+    char* isTouched = calloc((size_t)numVertices + 1, 1);
+    assert(lanes != 0 && visit != 0 && frontier != 0 && touched != 0);
+    assert(isTouched != 0);
+    int frontierSize = 0;
+    for (int i = 0; i < numSources; ++i)
+    {
+        uint32_t source = (uint32_t)sources[i];
+        uint64_t bit = (uint64_t)1 << (i & 63);
+        if (!isTouched[source])
+        {
+            isTouched[source] = 1;
+            frontier[frontierSize++] = source;
+        }
+        lanes[source * stride + (i >> 6)] |= bit;
+        visit[(size_t)source * words + (i >> 6)] |= bit;
+        if (distances != NULL)
+        {
+            distances[(size_t)i * numVertices + source] = 0;
+        }
+    }
+    for (int i = 0; i < frontierSize; ++i)
+    {
+        isTouched[frontier[i]] = 0;
+    }
+
+    int level = 0;
+    while (frontierSize > 0)
+    {
+        ++level;
+
+        /* Push every frontier vertex's lanes to its neighbors. */
+        int numTouched = 0;
+        for (int i = 0; i < frontierSize; ++i)
+        {
+            uint32_t v = frontier[i];
+            uint64_t* current = visit + (size_t)v * words;
+            for (uint64_t j = graph->offsets[v]; j < graph->offsets[v + 1];
+                 ++j)
+            {
+                uint32_t neighbor = graph->neighbors[j];
+                uint64_t* known = lanes + neighbor * stride;
+                uint64_t any = 0;
+                for (int k = 0; k < words; ++k)
+                {
+                    uint64_t fresh = current[k] & ~known[k];
+                    known[words + k] |= fresh;
+                    any |= fresh;
+                }
+                if (any != 0 && !isTouched[neighbor])
+                {
+                    isTouched[neighbor] = 1;
+                    touched[numTouched++] = neighbor;
+                }
+            }
+            for (int k = 0; k < words; ++k)
+            {
+                current[k] = 0;
+            }
+        }
+
+        /* Lanes new at a vertex form its frontier for the next level. */
+        for (int i = 0; i < numTouched; ++i)
+        {
+            uint32_t v = touched[i];
+            isTouched[v] = 0;
+            uint64_t* known = lanes + v * stride;
+            for (int k = 0; k < words; ++k)
+            {
+                uint64_t fresh = known[words + k];
+                known[k] |= fresh;
+                known[words + k] = 0;
+                visit[(size_t)v * words + k] = fresh;
+                while (distances != NULL && fresh != 0)
+                {
+                    int lane = k * 64 + __builtin_ctzll(fresh);
+                    distances[(size_t)lane * numVertices + v] = level;
+                    fresh &= fresh - 1;
+                }
+            }
+        }
+        uint32_t* temp = frontier;
+        frontier = touched;
+        touched = temp;
+        frontierSize = numTouched;
+    }
+
+    for (int v = 0; v < numVertices; ++v)
+    {
+        memcpy(seen + (size_t)v * words, lanes + v * stride,
+               sizeof(uint64_t) * words);
+    }
+    free(lanes);
+    free(visit);
+    free(frontier);
+    free(touched);
+    free(isTouched);
+    return level - 1;
+}
+
+/**
+ * Runs a breadth-first search from each of up to MAX_LANES sources at once,
+ * sharing every adjacency scan among all of them. Costs about as much as a
+ * single search per 64 sources, instead of one per source.
+ * @param graph
+ * @param sources Indices of the source vertices, repeats allowed.
+ * @param numSources Number of sources, from 1 to MAX_LANES (256).
+ * @param reached NULL, or an array of numVertices * words words, where
+ *        words = (numSources + 63) / 64. Bit i % 64 of word
+ *        reached[v * words + i / 64] is set if v is reachable from
+ *        sources[i].
+ * @param distances NULL, or an array of numSources * numVertices entries.
+ *        distances[i * numVertices + v] is set to the number of edges on a
+ *        shortest path from sources[i] to v, or -1 if v is unreachable.
+ * @return The largest distance from any source to a vertex it reaches.
+ */
+int csrBfsMultiSource(CsrGraph* graph, const int* sources, int numSources,
+                      uint64_t* reached, int* distances)
+{
+    assert(numSources > 0 && numSources <= MAX_LANES);
+    int numVertices = graph->numVertices;
+    for (int i = 0; i < numSources; ++i)
+    {
+        assert(sources[i] >= 0 && sources[i] < numVertices);
+    }
+    int words = (numSources + 63) / 64;
+    uint64_t* seen = reached;
+    if (seen == NULL)
+    {
+        seen = malloc(sizeof(uint64_t) * ((size_t)numVertices * words + 1));
+        assert(seen != 0);
+    }
+    if (distances != NULL)
+    {
+        memset(distances, 0xff,
+               sizeof(int) * (size_t)numSources * numVertices);
+    }
+
+    int depth;
+    switch (words)
+    {
+    case 1:
+        depth = multiSourceRun(graph, sources, numSources, seen, distances, 1);
+        break;
+    case 2:
+        depth = multiSourceRun(graph, sources, numSources, seen, distances, 2);
+        break;
+    case 3:
+        depth = multiSourceRun(graph, sources, numSources, seen, distances, 3);
+        break;
+    default:
+        depth = multiSourceRun(graph, sources, numSources, seen, distances, 4);
+        break;
+    }
+    if (seen != reached)
+    {
+        free(seen);
+    }
+    return depth;
+}
+
+/**
+ * Answers reachability queries MAX_LANES at a time with csrBfsMultiSource,
+ * so each batch of queries costs a few searches' worth of memory traffic.
+ * Sets each query's reachable field.
+ * @param graph
+ * @param queries
+ * @param numQueries
+ */
+void csrQueryBatch(CsrGraph* graph, ReachabilityQuery* queries,
+                   int numQueries)
+{
+    int numVertices = graph->numVertices;
+    int sources[MAX_LANES];
+    uint64_t* reached = malloc(sizeof(uint64_t) *
+                               ((size_t)numVertices * MAX_LANE_WORDS + 1));
+    assert(reached != 0);
+    for (int begin = 0; begin < numQueries; begin += MAX_LANES)
+    {
+        int count = numQueries - begin < MAX_LANES ? numQueries - begin
+                                                   : MAX_LANES;
+        int words = (count + 63) / 64;
+        for (int i = 0; i < count; ++i)
+        {
+            sources[i] = queries[begin + i].source;
+        }
+        csrBfsMultiSource(graph, sources, count, reached, NULL);
+        for (int i = 0; i < count; ++i)
+        {
+            ReachabilityQuery* query = &queries[begin + i];
+            assert(query->destination >= 0
+                   && query->destination < numVertices);
+            uint64_t word = reached[(size_t)query->destination * words
+                                    + (i >> 6)];
+            query->reachable = (int)((word >> (i & 63)) & 1);
+        }
+    }
+    free(reached);
+}
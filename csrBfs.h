@@ -0,0 +1,22 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Whole-graph breadth-first searches over CSR graphs.
+ */
+
+#ifndef CSR_BFS_H
+#define CSR_BFS_H
+
+#include "csrGraph.h"
+#include "traversal.h"
+
+int csrBfsTopDown(CsrGraph* graph, int source, int* parents);
+int csrBfsDirectionOptimizing(CsrGraph* graph, int source, int* parents);
+int csrBfsParallel(CsrGraph* graph, int source, int* distances, int* parents,
+                   int numThreads);
+int csrBfsMultiSource(CsrGraph* graph, const int* sources, int numSources,
+                      uint64_t* reached, int* distances);
+void csrQueryBatch(CsrGraph* graph, ReachabilityQuery* queries,
+                   int numQueries);
+
+#endif
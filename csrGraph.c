@@ -0,0 +1,457 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * CsrGraph implementation file.
+ *
+ * A CSR graph stores all adjacency lists back to back in one array of 32-bit
+ * vertex indices, with an offsets array marking where each list starts.
+ * Scanning a vertex's neighbors reads one contiguous run of memory instead of
+ * following a pointer per neighbor into separate Vertex blocks, and each
+ * neighbor takes 4 bytes instead of 8.
+ *
+ * The same two arrays are the body of the binary file format, so a saved
+ * graph is mapped and used in place without parsing:
+ *
+ *   CsrFileHeader  64 bytes
+ *   offsets        (numVertices + 1) uint64_t
+ *   neighbors      offsets[numVertices] uint32_t, at a 64-byte boundary
+ */
+
+#include "csrGraph.h"
+#include "traversal.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CSR_FILE_MAGIC 0x47525343u /* "CSRG" */
+#define CSR_FILE_VERSION 1u
+/* Written in native byte order; reads back differently on the wrong one. */
+#define CSR_BYTE_ORDER 0x01020304u
+
+typedef struct CsrFileHeader CsrFileHeader;
+
+struct CsrFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t headerSize;
+    uint64_t numVertices;
+    uint64_t numEdges;
+    uint64_t numEntries;
+    uint64_t offsetsStart;
+    uint64_t neighborsStart;
+    uint64_t fileSize;
+};
+
+/**
+ * Builds a CSR copy of the graph. The graph is not modified.
+ * @param graph
+ * @return The CSR graph.
+ */
+CsrGraph* csrFromGraph(Graph* graph)
+{
+    CsrGraph* csr = malloc(sizeof(CsrGraph));
+    assert(csr != 0);
+    csr->image = NULL;
+    csr->imageSize = 0;
+    csr->isMapped = 0;
+    int numVertices = graph->numVertices;
+    csr->numVertices = numVertices;
+    csr->numEdges = graph->numEdges;
+    csr->offsets = malloc(sizeof(uint64_t) * (numVertices + 1));
+    assert(csr->offsets != 0);
+    
+    uint64_t total = 0;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        csr->offsets[i] = total;
+        total += graph->vertexSet[i].numNeighbors;
+    }
+    csr->offsets[numVertices] = total;
+    
+    csr->neighbors = malloc(sizeof(uint32_t) * (total + 1));
+    assert(csr->neighbors != 0);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        Vertex* vertex = &graph->vertexSet[i];
+        uint32_t* out = csr->neighbors + csr->offsets[i];
+        for (int j = 0; j < vertex->numNeighbors; ++j)
+        {
+            out[j] = (uint32_t)(vertex->neighbors[j] - graph->vertexSet);
+        }
+    }
+    return csr;
+}
+
+/**
+ * Frees all memory allocated for a CSR graph and the graph itself, unmapping
+ * its file if it was loaded with csrMap.
+ * @param graph
+ */
+void csrDelete(CsrGraph* graph)
+{
+    if (graph->isMapped)
+    {
+        munmap(graph->image, graph->imageSize);
+    }
+    else
+    {
+        free(graph->offsets);
+        free(graph->neighbors);
+    }
+    free(graph);
+}
+
+/**
+ * Fills in the file header for a graph.
+ * @param header
+ * @param numVertices
+ * @param numEdges
+ * @param numEntries Length of the neighbors array.
+ */
+static void fillHeader(CsrFileHeader* header, uint64_t numVertices,
+                       uint64_t numEdges, uint64_t numEntries)
+{
+    memset(header, 0, sizeof(CsrFileHeader));
+    header->magic = CSR_FILE_MAGIC;
+    header->version = CSR_FILE_VERSION;
+    header->byteOrder = CSR_BYTE_ORDER;
+    header->headerSize = 64;
+    header->numVertices = numVertices;
+    header->numEdges = numEdges;
+    header->numEntries = numEntries;
+    header->offsetsStart = 64;
+    uint64_t offsetsEnd = 64 + sizeof(uint64_t) * (numVertices + 1);
+    header->neighborsStart = (offsetsEnd + 63) / 64 * 64;
+    header->fileSize = header->neighborsStart +
+                       sizeof(uint32_t) * numEntries;
+}
+
+/**
+ * Writes the graph in the binary format read by csrMap.
+ * @param graph
+ * @param fileName
+ * @return 1 on success, 0 otherwise.
+ */
+int csrSave(CsrGraph* graph, const char* fileName)
+{
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    uint64_t numVertices = (uint64_t)graph->numVertices;
+    uint64_t numEntries = graph->offsets[numVertices];
+    unsigned char block[64];
+    CsrFileHeader header;
+    fillHeader(&header, numVertices, (uint64_t)graph->numEdges, numEntries);
+    memset(block, 0, sizeof block);
+    memcpy(block, &header, sizeof header);
+    
+    size_t offsetsSize = sizeof(uint64_t) * (numVertices + 1);
+    size_t padding = header.neighborsStart - 64 - offsetsSize;
+    int ok = fwrite(block, 1, 64, file) == 64 &&
+             fwrite(graph->offsets, 1, offsetsSize, file) == offsetsSize;
+    memset(block, 0, sizeof block);
+    ok = ok && fwrite(block, 1, padding, file) == padding;
+    ok = ok && fwrite(graph->neighbors, sizeof(uint32_t), numEntries,
+                      file) == numEntries;
+    int closed = fclose(file) == 0;
+    return ok && closed;
+}
+
+/**
+ * Checks that the offsets never decrease or pass the end of the neighbors
+ * array, and that every neighbor is a vertex of the graph.
+ * @param offsets
+ * @param neighbors
+ * @param numVertices
+ * @param numEntries Length of the neighbors array.
+ * @return 1 if the arrays describe a graph, 0 otherwise.
+ */
+static int validArrays(const uint64_t* offsets, const uint32_t* neighbors,
+                       uint64_t numVertices, uint64_t numEntries)
+{
+    if (offsets[0] != 0 || offsets[numVertices] != numEntries)
+    {
+        return 0;
+    }
+    for (uint64_t i = 0; i < numVertices; i++)
+    {
+        if (offsets[i] > offsets[i + 1])
+        {
+            return 0;
+        }
+    }
+    for (uint64_t i = 0; i < numEntries; i++)
+    {
+        if (neighbors[i] >= numVertices)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Maps a file written by csrSave read-only and uses its arrays in place, so
+ * every process mapping the file shares one copy through the page cache.
+ * The arrays are read once to check them but never copied. The graph must
+ * not be modified.
+ * @param fileName
+ * @return The graph, or NULL if the file is missing or not a valid graph.
+ */
+CsrGraph* csrMap(const char* fileName)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < 64)
+    {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    void* image = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED)
+    {
+        return NULL;
+    }
+    
+    /* Check the header against the layout it implies. */
+    const CsrFileHeader* header = image;
+    CsrFileHeader expected;
+    int valid = header->magic == CSR_FILE_MAGIC
+                && header->version == CSR_FILE_VERSION
+                && header->byteOrder == CSR_BYTE_ORDER
+                && header->numVertices <= INT32_MAX
+                && header->numEdges <= INT32_MAX
+                && header->numEntries <= size / sizeof(uint32_t)
+                && header->numEntries == 2 * header->numEdges;
+    if (valid)
+    {
+        fillHeader(&expected, header->numVertices, header->numEdges,
+                   header->numEntries);
+        valid = memcmp(header, &expected, sizeof expected) == 0
+                && expected.fileSize == size;
+    }
+    uint64_t* offsets = (uint64_t*)((char*)image + 64);
+    uint32_t* neighbors = NULL;
+    if (valid)
+    {
+        neighbors = (uint32_t*)((char*)image + header->neighborsStart);
+        valid = validArrays(offsets, neighbors, header->numVertices,
+                            header->numEntries);
+    }
+    if (!valid)
+    {
+        munmap(image, size);
+        return NULL;
+    }
+    
+    CsrGraph* graph = malloc(sizeof(CsrGraph));
+    assert(graph != 0);
+    graph->numVertices = (int)header->numVertices;
+    graph->numEdges = (int)header->numEdges;
+    graph->offsets = offsets;
+    graph->neighbors = neighbors;
+    graph->image = image;
+    graph->imageSize = size;
+    graph->isMapped = 1;
+    return graph;
+}
+
+/**
+ * Recursive helper function for csrDfsRecursive.
+ * @param graph
+ * @param visited
+ * @param vertex
+ * @param destination
+ * @return 1 if there is a path, 0 otherwise.
+ */
+static int csrDfsRecursiveHelper(CsrGraph* graph, VisitedSet* visited,
+                                 uint32_t vertex, uint32_t destination)
+{
+    visitedSetAdd(visited, vertex);
+    if (vertex == destination)
+    {
+        return 1;
+    }
+    for (uint64_t i = graph->offsets[vertex]; i < graph->offsets[vertex + 1];
+         ++i)
+    {
+        uint32_t neighbor = graph->neighbors[i];
+        if (!visitedSetContains(visited, neighbor) &&
+            csrDfsRecursiveHelper(graph, visited, neighbor, destination))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Determines if there is a path from the source to the destination using a
+ * recursive depth-first search starting at the source.
+ * @param graph
+ * @param source Index of the source vertex.
+ * @param destination Index of the destination vertex.
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int csrDfsRecursive(CsrGraph* graph, int source, int destination)
+{
+    return csrDfsRecursiveContext(graph, traversalDefaultContext(), source,
+                                  destination);
+}
+
+/**
+ * Same as csrDfsRecursive, but keeps all traversal state in the given
+ * context, so searches with different contexts can run concurrently.
+ * @param graph
+ * @param context
+ * @param source Index of the source vertex.
+ * @param destination Index of the destination vertex.
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int csrDfsRecursiveContext(CsrGraph* graph, TraversalContext* context,
+                           int source, int destination)
+{
+    traversalContextReset(context, graph->numVertices);
+    return csrDfsRecursiveHelper(graph, context->visited, (uint32_t)source,
+                                 (uint32_t)destination);
+}
+
+/**
+ * Determines if there is a path from the source to the destination using an
+ * iterative depth-first search starting at the source.
+ * @param graph
+ * @param source Index of the source vertex.
+ * @param destination Index of the destination vertex.
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int csrDfsIterative(CsrGraph* graph, int source, int destination)
+{
+    return csrDfsIterativeContext(graph, traversalDefaultContext(), source,
+                                  destination);
+}
+
+/**
+ * Same as csrDfsIterative, but keeps all traversal state in the given
+ * context.
+ * @param graph
+ * @param context
+ * @param source Index of the source vertex.
+ * @param destination Index of the destination vertex.
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int csrDfsIterativeContext(CsrGraph* graph, TraversalContext* context,
+                           int source, int destination)
+{
+    if (source == destination)
+    {
+        return 1;
+    }
+    
+    /* Each vertex is pushed at most once, so numVertices slots suffice. */
+    traversalContextReset(context, graph->numVertices);
+    VisitedSet* visited = context->visited;
+    uint32_t* stack = context->buffer;
+    int top = 0;
+    int found = 0;
+    stack[top++] = (uint32_t)source;
+    visitedSetAdd(visited, source);
+    
+    while (top > 0 && !found)
+    {
+        uint32_t cur = stack[--top];
+        for (uint64_t i = graph->offsets[cur]; i < graph->offsets[cur + 1];
+             ++i)
+        {
+            uint32_t neighbor = graph->neighbors[i];
+            if (!visitedSetContains(visited, neighbor))
+            {
+                if (neighbor == (uint32_t)destination)
+                {
+                    found = 1;
+                    break;
+                }
+                visitedSetAdd(visited, neighbor);
+                stack[top++] = neighbor;
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * Determines if there is a path from the source to the destination using an
+ * iterative breadth-first search starting at the source.
+ * @param graph
+ * @param source Index of the source vertex.
+ * @param destination Index of the destination vertex.
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int csrBfsIterative(CsrGraph* graph, int source, int destination)
+{
+    return csrBfsIterativeContext(graph, traversalDefaultContext(), source,
+                                  destination);
+}
+
+/**
+ * Same as csrBfsIterative, but keeps all traversal state in the given
+ * context.
+ * @param graph
+ * @param context
+ * @param source Index of the source vertex.
+ * @param destination Index of the destination vertex.
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int csrBfsIterativeContext(CsrGraph* graph, TraversalContext* context,
+                           int source, int destination)
+{
+    if (source == destination)
+    {
+        return 1;
+    }
+    
+    /* Each vertex is enqueued at most once, so a plain array is the queue. */
+    traversalContextReset(context, graph->numVertices);
+    VisitedSet* visited = context->visited;
+    uint32_t* queue = context->buffer;
+    int head = 0;
+    int tail = 0;
+    int found = 0;
+    queue[tail++] = (uint32_t)source;
+    visitedSetAdd(visited, source);
+    
+    while (head < tail && !found)
+    {
+        uint32_t cur = queue[head++];
+        for (uint64_t i = graph->offsets[cur]; i < graph->offsets[cur + 1];
+             ++i)
+        {
+            uint32_t neighbor = graph->neighbors[i];
+            if (!visitedSetContains(visited, neighbor))
+            {
+                if (neighbor == (uint32_t)destination)
+                {
+                    found = 1;
+                    break;
+                }
+                visitedSetAdd(visited, neighbor);
+                queue[tail++] = neighbor;
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,42 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Compressed sparse row (CSR) graph for fast traversals.
+ */
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "graph.h"
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct CsrGraph CsrGraph;
+
+/**
+ * The neighbors of vertex v are neighbors[offsets[v]] through
+ * neighbors[offsets[v + 1] - 1]. Every undirected edge appears in the lists of
+ * both its endpoints. A graph loaded with csrMap points into the mapped file,
+ * image, and must not be modified.
+ */
+struct CsrGraph
+{
+    int numVertices;
+    int numEdges;
+    uint64_t* offsets;
+    uint32_t* neighbors;
+    void* image;
+    size_t imageSize;
+    int isMapped;
+};
+
+CsrGraph* csrFromGraph(Graph* graph);
+void csrDelete(CsrGraph* graph);
+int csrSave(CsrGraph* graph, const char* fileName);
+CsrGraph* csrMap(const char* fileName);
+
+int csrDfsRecursive(CsrGraph* graph, int source, int destination);
+int csrDfsIterative(CsrGraph* graph, int source, int destination);
+int csrBfsIterative(CsrGraph* graph, int source, int destination);
+
+#endif
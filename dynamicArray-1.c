@@ -5,6 +5,7 @@
  */
 
 #include "dynamicArray.h"
+#include "dynamicArrayReport.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
@@ -433,6 +434,50 @@ void dyPrint(DynamicArray* array, printFunction print)
     printf("]\n");
 }
 
+/**
+ * Writes the array through a writer. Text keeps the dyPrint layout, CSV
+ * writes an index,value row per element, and binary writes the size followed
+ * by each element. report formats a single element in the writer's format.
+ */
+void dyReport(DynamicArray* array, ReportWriter* writer,
+              void (*report)(ReportWriter*, TYPE))
+{
+    ReportFormat format = reportFormat(writer);
+    if (format == REPORT_TEXT)
+    {
+        reportWriteString(writer, "\nsize: ");
+        reportWriteInt(writer, array->size);
+        reportWriteString(writer, "\ncapacity: ");
+        reportWriteInt(writer, array->capacity);
+        reportWriteString(writer, "\n[\n");
+    }
+    else if (format == REPORT_CSV)
+    {
+        reportWriteString(writer, "index,value\n");
+    }
+    else
+    {
+        reportWriteBinaryInt(writer, array->size);
+    }
+    for (int i = 0; i < array->size; i++)
+    {
+        if (format != REPORT_BINARY)
+        {
+            reportWriteInt(writer, i);
+            reportWriteString(writer, format == REPORT_TEXT ? " : " : ",");
+        }
+        report(writer, array->data[i]);
+        if (format != REPORT_BINARY)
+        {
+            reportWriteChar(writer, '\n');
+        }
+    }
+    if (format == REPORT_TEXT)
+    {
+        reportWriteString(writer, "]\n");
+    }
+}
+
 void dyCopy(DynamicArray* source, DynamicArray* destination)
 {
     free(destination->data);
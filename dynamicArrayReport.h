@@ -0,0 +1,16 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Writing a DynamicArray through a ReportWriter.
+ */
+
+#ifndef DYNAMIC_ARRAY_REPORT_H
+#define DYNAMIC_ARRAY_REPORT_H
+
+#include "dynamicArray.h"
+#include "reportWriter.h"
+
+void dyReport(DynamicArray* array, ReportWriter* writer,
+              void (*report)(ReportWriter*, TYPE));
+
+#endif
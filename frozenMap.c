@@ -0,0 +1,476 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * FrozenMap implementation file.
+ *
+ * A frozen map is an immutable snapshot of a HashMap. Keys are placed with a
+ * hash-and-displace (CHD style) minimal perfect hash: every key hashes to a
+ * small bucket, and each bucket stores one pilot value that displaces its
+ * keys into distinct free slots of a table with exactly one slot per key. A
+ * lookup is one pilot read, one offset read and one key compare, with no
+ * chains to follow.
+ *
+ * The whole map lives in a single image that is also the file format:
+ *
+ *     header | pilots[numBuckets] | offsets[numKeys + 1] | values[numKeys] |
+ *     key blob
+ *
+ * Key i occupies blob[offsets[i], offsets[i + 1]) including its terminating
+ * '\0'. Every section is 4-byte aligned, so a loaded file is used in place.
+ */
+
+#include "frozenMap.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define FROZEN_MAP_MAGIC 0x4d5a5246u /* "FRZM" */
+#define FROZEN_MAP_VERSION 1u
+#define KEYS_PER_BUCKET 4
+#define PILOTS_PER_KEY 64
+
+typedef struct FrozenHeader FrozenHeader;
+
+struct FrozenHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numKeys;
+    uint32_t numBuckets;
+    uint64_t blobSize;
+};
+
+struct FrozenMap
+{
+    const FrozenHeader* header;
+    const uint32_t* pilots;
+    const uint32_t* offsets;
+    const int* values;
+    const char* blob;
+    void* image;       /* Start of the image, malloc'd or mmapped */
+    size_t imageSize;
+    int isMapped;
+};
+
+/**
+ * 64-bit FNV-1a hash of the key followed by a finalizer so that the low bits
+ * used for the bucket are well mixed.
+ * @param key
+ * @return 64-bit hash.
+ */
+static uint64_t keyHash(const char* key)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (const unsigned char* c = (const unsigned char*)key; *c != '\0'; c++)
+    {
+        h ^= *c;
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Returns the table slot of a key hash displaced by the given pilot.
+ * @param hash
+ * @param pilot
+ * @param numKeys
+ * @return Slot in [0, numKeys).
+ */
+static uint32_t slotOf(uint64_t hash, uint32_t pilot, uint32_t numKeys)
+{
+    uint64_t h = hash ^ ((uint64_t)pilot * 0x9e3779b97f4a7c15ull);
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 29;
+    return (uint32_t)(h % numKeys);
+}
+
+static size_t align4(size_t size)
+{
+    return (size + 3) & ~(size_t)3;
+}
+
+/**
+ * Points the section pointers of the map into its image.
+ * @param map
+ */
+static void bindSections(FrozenMap* map)
+{
+    const char* base = map->image;
+    map->header = (const FrozenHeader*)base;
+    size_t offset = sizeof(FrozenHeader);
+    map->pilots = (const uint32_t*)(base + offset);
+    offset += sizeof(uint32_t) * map->header->numBuckets;
+    map->offsets = (const uint32_t*)(base + offset);
+    offset += sizeof(uint32_t) * (map->header->numKeys + 1);
+    map->values = (const int*)(base + offset);
+    offset += sizeof(int) * map->header->numKeys;
+    map->blob = base + offset;
+}
+
+/**
+ * Returns the image size needed for the given key count, bucket count and
+ * total key bytes.
+ */
+static size_t imageSize(uint32_t numKeys, uint32_t numBuckets, size_t blobSize)
+{
+    return sizeof(FrozenHeader)
+        + sizeof(uint32_t) * numBuckets
+        + sizeof(uint32_t) * ((size_t)numKeys + 1)
+        + sizeof(int) * (size_t)numKeys
+        + align4(blobSize);
+}
+
+/**
+ * Builds a frozen copy of the map. The map itself is not modified and can be
+ * deleted afterwards. Fails only if some bucket's keys collide under every
+ * pilot, as two keys with the same 64-bit hash do.
+ * @param map
+ * @return The frozen map, to be freed with frozenMapDelete, or NULL if no
+ * perfect hash was found.
+ */
+FrozenMap* hashMapFreeze(HashMap* map)
+{
+    assert(map != 0);
+    
+    /* Gather links and their hashes. */
+    uint32_t numKeys = (uint32_t)map->size;
+    HashLink** links = malloc(sizeof(HashLink*) * (numKeys + 1));
+    uint64_t* hashes = malloc(sizeof(uint64_t) * (numKeys + 1));
+    assert(links != 0 && hashes != 0);
+    size_t blobSize = 0;
+    uint32_t n = 0;
+    for (int i = 0; i < map->capacity; i++)
+    {
+        for (HashLink* link = map->table[i]; link != NULL; link = link->next)
+        {
+            links[n] = link;
+            hashes[n] = keyHash(link->key);
+            blobSize += strlen(link->key) + 1;
+            n++;
+        }
+    }
+    assert(n == numKeys);
+    uint32_t numBuckets = numKeys / KEYS_PER_BUCKET + 1;
+    
+    /* Group keys by bucket with a counting sort. */
+    uint32_t* bucketStart = calloc(numBuckets + 1, sizeof(uint32_t));
+    uint32_t* bucketKeys = malloc(sizeof(uint32_t) * (numKeys + 1));
+    assert(bucketStart != 0 && bucketKeys != 0);
+    for (uint32_t k = 0; k < numKeys; k++)
+    {
+        bucketStart[hashes[k] % numBuckets + 1]++;
+    }
+    uint32_t maxBucketSize = 0;
+    for (uint32_t b = 0; b < numBuckets; b++)
+    {
+        if (bucketStart[b + 1] > maxBucketSize)
+        {
+            maxBucketSize = bucketStart[b + 1];
+        }
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    uint32_t* fill = malloc(sizeof(uint32_t) * numBuckets);
+    assert(fill != 0);
+    memcpy(fill, bucketStart, sizeof(uint32_t) * numBuckets);
+    for (uint32_t k = 0; k < numKeys; k++)
+    {
+        bucketKeys[fill[hashes[k] % numBuckets]++] = k;
+    }
+    
+    /* Order buckets from largest to smallest, again by counting sort. */
+    uint32_t* sizeStart = calloc(maxBucketSize + 2, sizeof(uint32_t));
+    uint32_t* order = malloc(sizeof(uint32_t) * numBuckets);
+    assert(sizeStart != 0 && order != 0);
+    for (uint32_t b = 0; b < numBuckets; b++)
+    {
+        uint32_t size = bucketStart[b + 1] - bucketStart[b];
+        sizeStart[maxBucketSize - size + 1]++;
+    }
+    for (uint32_t s = 0; s <= maxBucketSize; s++)
+    {
+        sizeStart[s + 1] += sizeStart[s];
+    }
+    for (uint32_t b = 0; b < numBuckets; b++)
+    {
+        uint32_t size = bucketStart[b + 1] - bucketStart[b];
+        order[sizeStart[maxBucketSize - size]++] = b;
+    }
+    
+    /* Find a pilot for each bucket that puts all its keys in free slots. */
+    size_t size = imageSize(numKeys, numBuckets, blobSize);
+    FrozenMap* frozen = malloc(sizeof(FrozenMap));
+    assert(frozen != 0);
+    frozen->image = calloc(1, size);
+    assert(frozen->image != 0);
+    frozen->imageSize = size;
+    frozen->isMapped = 0;
+    FrozenHeader* header = frozen->image;
+    header->magic = FROZEN_MAP_MAGIC;
+    header->version = FROZEN_MAP_VERSION;
+    header->numKeys = numKeys;
+    header->numBuckets = numBuckets;
+    header->blobSize = blobSize;
+    bindSections(frozen);
+    uint32_t* pilots = (uint32_t*)frozen->pilots;
+    
+    uint32_t* slotKey = malloc(sizeof(uint32_t) * (numKeys + 1));
+    uint32_t* slots = malloc(sizeof(uint32_t) * (maxBucketSize + 1));
+    unsigned char* taken = calloc(numKeys + 1, 1);
+    assert(slotKey != 0 && slots != 0 && taken != 0);
+    /* The last buckets placed may have a single free slot left, which a
+     * pilot hits with probability 1 / numKeys, so the search allows many
+     * times that many pilots before giving up. */
+    uint64_t maxPilot = (uint64_t)PILOTS_PER_KEY * numKeys + 1;
+    if (maxPilot > UINT32_MAX)
+    {
+        maxPilot = UINT32_MAX;
+    }
+    int found = 1;
+    for (uint32_t i = 0; found && i < numBuckets; i++)
+    {
+        uint32_t b = order[i];
+        uint32_t first = bucketStart[b];
+        uint32_t count = bucketStart[b + 1] - first;
+        if (count == 0)
+        {
+            break;
+        }
+        found = 0;
+        for (uint32_t pilot = 0; pilot < maxPilot; pilot++)
+        {
+            uint32_t placed = 0;
+            while (placed < count)
+            {
+                uint32_t slot = slotOf(hashes[bucketKeys[first + placed]],
+                                       pilot, numKeys);
+                if (taken[slot])
+                {
+                    break;
+                }
+                taken[slot] = 1;
+                slots[placed++] = slot;
+            }
+            if (placed == count)
+            {
+                pilots[b] = pilot;
+                for (uint32_t j = 0; j < count; j++)
+                {
+                    slotKey[slots[j]] = bucketKeys[first + j];
+                }
+                found = 1;
+                break;
+            }
+            /* Undo the partial placement and try the next pilot. */
+            for (uint32_t j = 0; j < placed; j++)
+            {
+                taken[slots[j]] = 0;
+            }
+        }
+    }
+    
+    if (found)
+    {
+        /* Lay out offsets, values and keys in slot order. */
+        uint32_t* offsets = (uint32_t*)frozen->offsets;
+        int* values = (int*)frozen->values;
+        char* blob = (char*)frozen->blob;
+        uint32_t offset = 0;
+        for (uint32_t slot = 0; slot < numKeys; slot++)
+        {
+            HashLink* link = links[slotKey[slot]];
+            size_t length = strlen(link->key) + 1;
+            offsets[slot] = offset;
+            values[slot] = link->value;
+            memcpy(blob + offset, link->key, length);
+            offset += (uint32_t)length;
+        }
+        offsets[numKeys] = offset;
+    }
+    else
+    {
+        frozenMapDelete(frozen);
+        frozen = NULL;
+    }
+    
+    free(taken);
+    free(slots);
+    free(slotKey);
+    free(order);
+    free(sizeStart);
+    free(fill);
+    free(bucketKeys);
+    free(bucketStart);
+    free(hashes);
+    free(links);
+    return frozen;
+}
+
+/**
+ * Frees the frozen map, unmapping its file if it was loaded with
+ * frozenMapLoad.
+ * @param map
+ */
+void frozenMapDelete(FrozenMap* map)
+{
+    if (map->isMapped)
+    {
+        munmap(map->image, map->imageSize);
+    }
+    else
+    {
+        free(map->image);
+    }
+    free(map);
+}
+
+/**
+ * Returns a pointer to the value for the given key, or NULL if the key is not
+ * in the map. The value is read-only.
+ * @param map
+ * @param key
+ * @return Pointer to the value or NULL.
+ */
+const int* frozenMapGet(FrozenMap* map, const char* key)
+{
+    uint32_t numKeys = map->header->numKeys;
+    if (numKeys == 0)
+    {
+        return NULL;
+    }
+    uint64_t hash = keyHash(key);
+    uint32_t pilot = map->pilots[hash % map->header->numBuckets];
+    uint32_t slot = slotOf(hash, pilot, numKeys);
+    if (strcmp(map->blob + map->offsets[slot], key) != 0)
+    {
+        return NULL;
+    }
+    return &map->values[slot];
+}
+
+/**
+ * Returns 1 if the key is in the map and 0 otherwise.
+ * @param map
+ * @param key
+ * @return 1 if the key is found, 0 otherwise.
+ */
+int frozenMapContainsKey(FrozenMap* map, const char* key)
+{
+    return frozenMapGet(map, key) != NULL;
+}
+
+/**
+ * Returns the number of keys in the map.
+ * @param map
+ * @return Number of keys.
+ */
+int frozenMapSize(FrozenMap* map)
+{
+    return (int)map->header->numKeys;
+}
+
+/**
+ * Writes the map image to the given file.
+ * @param map
+ * @param fileName
+ * @return 1 on success, 0 otherwise.
+ */
+int frozenMapSave(FrozenMap* map, const char* fileName)
+{
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    size_t written = fwrite(map->image, 1, map->imageSize, file);
+    int closed = fclose(file) == 0;
+    return written == map->imageSize && closed;
+}
+
+/**
+ * Checks that every key lies inside the blob and ends with its terminating
+ * '\0', so lookups never read past the image.
+ * @param map
+ * @return 1 if the keys are valid, 0 otherwise.
+ */
+static int validKeys(FrozenMap* map)
+{
+    uint32_t numKeys = map->header->numKeys;
+    const uint32_t* offsets = map->offsets;
+    if (offsets[0] != 0 || offsets[numKeys] != map->header->blobSize)
+    {
+        return 0;
+    }
+    for (uint32_t i = 0; i < numKeys; i++)
+    {
+        if (offsets[i] >= offsets[i + 1]
+            || offsets[i + 1] > map->header->blobSize
+            || map->blob[offsets[i + 1] - 1] != '\0')
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Maps a file written by frozenMapSave read-only and uses it in place. Pages
+ * are shared through the page cache by every process mapping the same file.
+ * @param fileName
+ * @return The frozen map, or NULL if the file is missing or not a valid image.
+ */
+FrozenMap* frozenMapLoad(const char* fileName)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(FrozenHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    void* image = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED)
+    {
+        return NULL;
+    }
+    
+    const FrozenHeader* header = image;
+    if (header->magic != FROZEN_MAP_MAGIC
+        || header->version != FROZEN_MAP_VERSION
+        || header->numBuckets == 0
+        || header->blobSize > size
+        || imageSize(header->numKeys, header->numBuckets,
+                     header->blobSize) != size)
+    {
+        munmap(image, size);
+        return NULL;
+    }
+    
+    FrozenMap* map = malloc(sizeof(FrozenMap));
+    assert(map != 0);
+    map->image = image;
+    map->imageSize = size;
+    map->isMapped = 1;
+    bindSections(map);
+    if (!validKeys(map))
+    {
+        frozenMapDelete(map);
+        return NULL;
+    }
+    return map;
+}
@@ -0,0 +1,25 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Read-only string to int map built from a HashMap with a minimal perfect
+ * hash.
+ */
+
+#ifndef FROZEN_MAP_H
+#define FROZEN_MAP_H
+
+#include "hashMap.h"
+
+typedef struct FrozenMap FrozenMap;
+
+FrozenMap* hashMapFreeze(HashMap* map);
+void frozenMapDelete(FrozenMap* map);
+
+const int* frozenMapGet(FrozenMap* map, const char* key);
+int frozenMapContainsKey(FrozenMap* map, const char* key);
+int frozenMapSize(FrozenMap* map);
+
+int frozenMapSave(FrozenMap* map, const char* fileName);
+FrozenMap* frozenMapLoad(const char* fileName);
+
+#endif
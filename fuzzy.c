@@ -0,0 +1,371 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * FuzzyIndex implementation file.
+ *
+ * Uses symmetric deletion neighborhoods (as in SymSpell): two words are
+ * within edit distance k only if deleting at most k characters from each
+ * makes them equal. Every string obtained by deleting up to maxDistance
+ * characters from a key is stored in a HashMap whose value is the head of a
+ * list of the keys that produce it. A lookup generates the deletions of the
+ * query, collects the keys listed under them and verifies each candidate with
+ * a bit-parallel edit distance.
+ *
+ * Distances are counted in bytes, so a multibyte UTF-8 character counts as
+ * more than one edit.
+ */
+
+#include "fuzzy.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+typedef struct DeleteEntry DeleteEntry;
+
+struct DeleteEntry
+{
+    int key;        /* Index into keys */
+    int next;       /* Next entry for the same deletion, or -1 */
+};
+
+struct FuzzyIndex
+{
+    int maxDistance;
+    int numKeys;
+    const char** keys;
+    int* values;
+    HashMap* deletes;   /* Deletion string to head entry */
+    DeleteEntry* entries;
+    int numEntries;
+    int entryCapacity;
+    int* seen;          /* Per key, the last lookup that visited it */
+    int lookup;
+    FuzzyMatch* matches;
+    int matchCapacity;
+};
+
+/**
+ * Records that key produces the given deletion string, once per key.
+ * @param index
+ * @param deletion
+ * @param key
+ */
+static void addEntry(FuzzyIndex* index, const char* deletion, int key)
+{
+    int* head = hashMapGet(index->deletes, deletion);
+    if (head != NULL && index->entries[*head].key == key)
+    {
+        return;
+    }
+    if (index->numEntries == index->entryCapacity)
+    {
+        index->entryCapacity *= 2;
+        index->entries = realloc(index->entries,
+                                 sizeof(DeleteEntry) * index->entryCapacity);
+        assert(index->entries != 0);
+    }
+    DeleteEntry* entry = &index->entries[index->numEntries];
+    entry->key = key;
+    if (head != NULL)
+    {
+        entry->next = *head;
+        *head = index->numEntries;
+    }
+    else
+    {
+        entry->next = -1;
+        hashMapPut(index->deletes, deletion, index->numEntries);
+    }
+    index->numEntries++;
+}
+
+/**
+ * Calls addEntry for the word and every string made by deleting up to depth
+ * more characters at positions from start on.
+ */
+static void addDeletes(FuzzyIndex* index, char* word, int length, int start,
+                       int depth, int key)
+{
+    addEntry(index, word, key);
+    if (depth == 0)
+    {
+        return;
+    }
+    for (int i = start; i < length; i++)
+    {
+        char removed = word[i];
+        memmove(word + i, word + i + 1, length - i);
+        addDeletes(index, word, length - 1, i, depth - 1, key);
+        memmove(word + i + 1, word + i, length - i);
+        word[i] = removed;
+    }
+}
+
+/**
+ * Bit-parallel (Myers/Hyyrö) edit distance for a pattern of at most 64 bytes.
+ * Each column of the dynamic programming matrix is kept as vertical delta bit
+ * vectors, so a character of text is processed in a few word operations.
+ */
+static int myersDistance(const unsigned char* pattern, int m,
+                         const unsigned char* text, int n)
+{
+    uint64_t peq[256];
+    for (int i = 0; i < m; i++)
+    {
+        peq[pattern[i]] = 0;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        peq[text[i]] = 0;
+    }
+    for (int i = 0; i < m; i++)
+    {
+        peq[pattern[i]] |= 1ull << i;
+    }
+    
+    uint64_t pv = ~0ull;
+    uint64_t mv = 0;
+    uint64_t last = 1ull << (m - 1);
+    int score = m;
+    for (int j = 0; j < n; j++)
+    {
+        uint64_t eq = peq[text[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last)
+        {
+            score++;
+        }
+        else if (mh & last)
+        {
+            score--;
+        }
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+/**
+ * Returns the Levenshtein distance between two strings, counted in bytes.
+ * @param a
+ * @param b
+ * @return Minimum number of single byte insertions, deletions and
+ *         substitutions turning a into b.
+ */
+int editDistance(const char* a, const char* b)
+{
+    int m = (int)strlen(a);
+    int n = (int)strlen(b);
+    if (m == 0 || n == 0)
+    {
+        return m + n;
+    }
+    if (m <= 64)
+    {
+        return myersDistance((const unsigned char*)a, m,
+                             (const unsigned char*)b, n);
+    }
+    if (n <= 64)
+    {
+        return myersDistance((const unsigned char*)b, n,
+                             (const unsigned char*)a, m);
+    }
+    
+    /* Both longer than a machine word: one row of the usual table. */
+    int* row = malloc(sizeof(int) * (n + 1));
+    assert(row != 0);
+    for (int j = 0; j <= n; j++)
+    {
+        row[j] = j;
+    }
+    for (int i = 1; i <= m; i++)
+    {
+        int diagonal = row[0];
+        row[0] = i;
+        for (int j = 1; j <= n; j++)
+        {
+            int above = row[j];
+            int best = diagonal + (a[i - 1] != b[j - 1]);
+            if (above + 1 < best)
+            {
+                best = above + 1;
+            }
+            if (row[j - 1] + 1 < best)
+            {
+                best = row[j - 1] + 1;
+            }
+            row[j] = best;
+            diagonal = above;
+        }
+    }
+    int distance = row[n];
+    free(row);
+    return distance;
+}
+
+/**
+ * Builds an index over the map's keys for lookups within maxDistance edits.
+ * The index refers to the map's keys, so the map must not be changed or
+ * freed while the index is in use.
+ * @param map
+ * @param maxDistance Largest distance lookups may ask for.
+ * @return The index.
+ */
+FuzzyIndex* fuzzyIndexNew(HashMap* map, int maxDistance)
+{
+    assert(maxDistance >= 0);
+    FuzzyIndex* index = malloc(sizeof(FuzzyIndex));
+    assert(index != 0);
+    index->maxDistance = maxDistance;
+    index->numKeys = hashMapSize(map);
+    index->keys = malloc(sizeof(char*) * (index->numKeys + 1));
+    index->values = malloc(sizeof(int) * (index->numKeys + 1));
+    index->seen = calloc(index->numKeys + 1, sizeof(int));
+    index->entryCapacity = 1024;
+    index->numEntries = 0;
+    index->entries = malloc(sizeof(DeleteEntry) * index->entryCapacity);
+    index->deletes = hashMapNew(1024);
+    index->lookup = 0;
+    index->matchCapacity = 16;
+    index->matches = malloc(sizeof(FuzzyMatch) * index->matchCapacity);
+    assert(index->keys != 0 && index->values != 0 && index->seen != 0);
+    assert(index->entries != 0 && index->matches != 0);
+    
+    int key = 0;
+    int bufferLength = 64;
+    char* buffer = malloc(bufferLength);
+    assert(buffer != 0);
+    for (int i = 0; i < map->capacity; i++)
+    {
+        for (HashLink* link = map->table[i]; link != NULL; link = link->next)
+        {
+            int length = (int)strlen(link->key);
+            if (length + 1 > bufferLength)
+            {
+                bufferLength = length + 1;
+                buffer = realloc(buffer, bufferLength);
+                assert(buffer != 0);
+            }
+            memcpy(buffer, link->key, length + 1);
+            index->keys[key] = link->key;
+            index->values[key] = link->value;
+            addDeletes(index, buffer, length, 0, maxDistance, key);
+            key++;
+        }
+    }
+    free(buffer);
+    return index;
+}
+
+/**
+ * Frees the index. The map it was built from is not affected.
+ * @param index
+ */
+void fuzzyIndexDelete(FuzzyIndex* index)
+{
+    hashMapDelete(index->deletes);
+    free(index->entries);
+    free(index->keys);
+    free(index->values);
+    free(index->seen);
+    free(index->matches);
+    free(index);
+}
+
+/**
+ * Adds every key listed under the deletion string that is within
+ * maxDistance of the query to the index's matches.
+ */
+static void collect(FuzzyIndex* index, const char* deletion,
+                    const char* word, int length, int maxDistance,
+                    int* numMatches)
+{
+    int* head = hashMapGet(index->deletes, deletion);
+    for (int e = head ? *head : -1; e != -1; e = index->entries[e].next)
+    {
+        int key = index->entries[e].key;
+        if (index->seen[key] == index->lookup)
+        {
+            continue;
+        }
+        index->seen[key] = index->lookup;
+        int keyLength = (int)strlen(index->keys[key]);
+        if (abs(keyLength - length) > maxDistance)
+        {
+            continue;
+        }
+        int distance = editDistance(word, index->keys[key]);
+        if (distance > maxDistance)
+        {
+            continue;
+        }
+        if (*numMatches == index->matchCapacity)
+        {
+            index->matchCapacity *= 2;
+            index->matches = realloc(index->matches,
+                                     sizeof(FuzzyMatch) * index->matchCapacity);
+            assert(index->matches != 0);
+        }
+        FuzzyMatch* match = &index->matches[(*numMatches)++];
+        match->key = index->keys[key];
+        match->value = index->values[key];
+        match->distance = distance;
+    }
+}
+
+/**
+ * Visits the query and its deletions up to depth characters, collecting
+ * matches for each.
+ */
+static void lookupDeletes(FuzzyIndex* index, char* deletion, int length,
+                          int start, int depth, const char* word,
+                          int wordLength, int maxDistance, int* numMatches)
+{
+    collect(index, deletion, word, wordLength, maxDistance, numMatches);
+    if (depth == 0)
+    {
+        return;
+    }
+    for (int i = start; i < length; i++)
+    {
+        char removed = deletion[i];
+        memmove(deletion + i, deletion + i + 1, length - i);
+        lookupDeletes(index, deletion, length - 1, i, depth - 1, word,
+                      wordLength, maxDistance, numMatches);
+        memmove(deletion + i + 1, deletion + i, length - i);
+        deletion[i] = removed;
+    }
+}
+
+/**
+ * Finds every key within maxDistance edits of the word.
+ * @param index
+ * @param word
+ * @param maxDistance At most the distance the index was built for.
+ * @param matches Set to the matches, in no particular order. The array
+ *                belongs to the index and is reused by the next lookup.
+ * @return Number of matches.
+ */
+int fuzzyIndexLookup(FuzzyIndex* index, const char* word, int maxDistance,
+                     FuzzyMatch** matches)
+{
+    assert(maxDistance >= 0 && maxDistance <= index->maxDistance);
+    index->lookup++;
+    int length = (int)strlen(word);
+    char* deletion = malloc(length + 1);
+    assert(deletion != 0);
+    memcpy(deletion, word, length + 1);
+    int numMatches = 0;
+    lookupDeletes(index, deletion, length, 0, maxDistance, word, length,
+                  maxDistance, &numMatches);
+    free(deletion);
+    *matches = index->matches;
+    return numMatches;
+}
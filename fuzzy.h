@@ -0,0 +1,29 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Edit distance lookup over the keys of a HashMap.
+ */
+
+#ifndef FUZZY_H
+#define FUZZY_H
+
+#include "hashMap.h"
+
+typedef struct FuzzyIndex FuzzyIndex;
+typedef struct FuzzyMatch FuzzyMatch;
+
+struct FuzzyMatch
+{
+    const char* key;
+    int value;
+    int distance;
+};
+
+FuzzyIndex* fuzzyIndexNew(HashMap* map, int maxDistance);
+void fuzzyIndexDelete(FuzzyIndex* index);
+
+int fuzzyIndexLookup(FuzzyIndex* index, const char* word, int maxDistance,
+                     FuzzyMatch** matches);
+int editDistance(const char* a, const char* b);
+
+#endif
@@ -6,22 +6,41 @@
  */
 
 #include "graph.h"
-#include "deque.h"
+#include "graphReport.h"
+#include "traversal.h"
+#include "graphEdit.h"
+#include "graphLoader.h"
+#include "adjacency.h"
+#include "graphGenerator.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <unistd.h>
 
 /**
- * Clears isVisited in all nodes in the graph.
+ * Returns 1 if the vertex has been visited by the context's traversal.
  * @param graph
+ * @param context
+ * @param vertex
+ * @return 1 if visited, 0 otherwise.
  */
-static void clearVisited(Graph* graph)
+static int isVisited(Graph* graph, TraversalContext* context, Vertex* vertex)
 {
-    for (int i = 0; i < graph->numVertices; ++i)
-    {
-        graph->vertexSet[i].isVisited = 0;
-    }
+    return visitedSetContains(context->visited,
+                              (int)(vertex - graph->vertexSet));
+}
+
+/**
+ * Marks the vertex visited by the context's traversal.
+ * @param graph
+ * @param context
+ * @param vertex
+ */
+static void setVisited(Graph* graph, TraversalContext* context,
+                       Vertex* vertex)
+{
+    visitedSetAdd(context->visited, (int)(vertex - graph->vertexSet));
 }
 
 /**
@@ -29,13 +48,15 @@ static void clearVisited(Graph* graph)
  * from the given vertex to the destination using a recursive depth-first
  * search.
  * @param graph
+ * @param context
  * @param vertex
  * @param destination
  * @return 1 if there is a path, 0 otherwise.
  */
-static int DfsRecursiveHelper(Graph* graph, Vertex* vertex, Vertex* destination)
+static int DfsRecursiveHelper(Graph* graph, TraversalContext* context,
+                              Vertex* vertex, Vertex* destination)
 {
-    vertex->isVisited = 1;
+    setVisited(graph, context, vertex);
     if (vertex == destination)
     {
         return 1;
@@ -43,9 +64,10 @@ static int DfsRecursiveHelper(Graph* graph, Vertex* vertex, Vertex* destination)
     for (int i = 0; i < vertex->numNeighbors; ++i)
     {
         Vertex* neighbor = vertex->neighbors[i];
-        if (!neighbor->isVisited)
+        if (!isVisited(graph, context, neighbor))
         {
-            if (DfsRecursiveHelper(graph, neighbor, destination) == 1)
+            if (DfsRecursiveHelper(graph, context, neighbor,
+                                   destination) == 1)
             {
                 return 1;
             }
@@ -55,7 +77,8 @@ static int DfsRecursiveHelper(Graph* graph, Vertex* vertex, Vertex* destination)
 }
 
 /**
- * Determines if an edge (v1, v2) exists.
+ * Determines if an edge (v1, v2) exists. Looks in the shorter of the two
+ * lists, which hashes if it is a hub, so the cost does not grow with degree.
  * @param v1
  * @param v2
  * @return 1 if the edge exists, 0 otherwise.
@@ -66,31 +89,50 @@ static int isAdjacent(Vertex* v1, Vertex* v2)
     {
         return 1;
     }
-    for (int i = 0; i < v1->numNeighbors; ++i)
+    if (v1->numNeighbors <= v2->numNeighbors)
     {
-        if (v1->neighbors[i] == v2)
-        {
-            return 1;
-        }
+        return adjacencyContains(v1, v2);
     }
-    return 0;
+    return adjacencyContains(v2, v1);
 }
 
 /**
- * Connects two vertices by adding each other to their neighbors lists.
+ * Connects two vertices by adding each other to their neighbors lists. The
+ * lists grow geometrically, so adding an edge is amortized O(1).
  * @param v1
  * @param v2
  */
 static void createEdge(Vertex* v1, Vertex* v2)
 {
-    v1->neighbors = realloc(v1->neighbors,
-                            sizeof(Vertex*) * (v1->numNeighbors + 1));
-    v2->neighbors = realloc(v2->neighbors,
-                            sizeof(Vertex*) * (v2->numNeighbors + 1));
-    v1->neighbors[v1->numNeighbors] = v2;
-    v2->neighbors[v2->numNeighbors] = v1;
-    ++(v1->numNeighbors);
-    ++(v2->numNeighbors);
+    adjacencyAppend(v1, v2);
+    adjacencyAppend(v2, v1);
+}
+
+/**
+ * Adds the edge (u, v) to the graph unless it is a loop or already exists.
+ * If index is not NULL, merges the endpoints' components in it, so the index
+ * stays current without being rebuilt.
+ * @param graph
+ * @param index Component index of the graph, or NULL.
+ * @param u Index of the first vertex.
+ * @param v Index of the second vertex.
+ */
+void graphAddEdge(Graph* graph, ComponentIndex* index, int u, int v)
+{
+    assert(u >= 0 && u < graph->numVertices);
+    assert(v >= 0 && v < graph->numVertices);
+    Vertex* v1 = &graph->vertexSet[u];
+    Vertex* v2 = &graph->vertexSet[v];
+    if (isAdjacent(v1, v2))
+    {
+        return;
+    }
+    createEdge(v1, v2);
+    ++(graph->numEdges);
+    if (index != NULL)
+    {
+        componentIndexUnion(index, u, v);
+    }
 }
 
 /**
@@ -106,70 +148,97 @@ static void createEdge(Vertex* v1, Vertex* v2)
  */
 int dfsRecursive(Graph* graph, Vertex* source, Vertex* destination)
 {
-    clearVisited(graph);
-    return DfsRecursiveHelper(graph, source, destination);
+    return dfsRecursiveContext(graph, traversalDefaultContext(), source,
+                               destination);
+}
+
+/**
+ * Same as dfsRecursive, but keeps all traversal state in the given context
+ * and only reads the graph, so searches with different contexts can run on
+ * the same graph concurrently.
+ * @param graph
+ * @param context
+ * @param source
+ * @param destination
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int dfsRecursiveContext(Graph* graph, TraversalContext* context,
+                        Vertex* source, Vertex* destination)
+{
+    traversalContextReset(context, graph->numVertices);
+    return DfsRecursiveHelper(graph, context, source, destination);
 }
 
 /**
  * Determines if there is a path from the source to the destination using an
  * iterative depth-first search starting at the source.
  * 
- * Remember to call clearVisited() before starting the search.
- * 
  * @param graph
  * @param source
  * @param destination
  * @return 1 if there is a path, 0 otherwise.
  */
 int dfsIterative(Graph* graph, Vertex* source, Vertex* destination)
+{
+    return dfsIterativeContext(graph, traversalDefaultContext(), source,
+                               destination);
+}
+
+/**
+ * Same as dfsIterative, but keeps all traversal state in the given context.
+ * The context's reset clears the visited set in constant time.
+ * @param graph
+ * @param context
+ * @param source
+ * @param destination
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int dfsIterativeContext(Graph* graph, TraversalContext* context,
+                        Vertex* source, Vertex* destination)
 {
     // FIXME: Implement
     /* NOTE: As noted on piazza, based on provided code, did not appear separate container described in lecture for reachable vertices was necessary in this implementation. */
     
-    clearVisited(graph);
+    traversalContextReset(context, graph->numVertices);
     
     if(source == destination)
     {
         return 1;
     }
     
-    /* Use stack */
-    Deque* stack = dequeNew();
-    assert(stack != 0);
+    /* Use stack of vertex indices. Vertices are marked visited when pushed,
+     * so each is pushed at most once and the context's buffer of
+     * numVertices slots never overflows. */
+    Vertex* vertexSet = graph->vertexSet;
+    uint32_t* stack = context->buffer;
+    int top = 0;
     /* Start at source */
-    dequePushFront(stack, source);
-    source->isVisited = 1;
+    stack[top++] = (uint32_t)(source - vertexSet);
+    setVisited(graph, context, source);
     
-    while(!dequeIsEmpty(stack))
+    while(top > 0)
     {
-        Vertex* cur = dequeFront(stack);
-        dequePopFront(stack);
+        Vertex* cur = &vertexSet[stack[--top]];
         /* printf("pop: %d\n", cur->label); for testing */ 
-        cur->isVisited = 1;
         Vertex* neighbor;
         for(int i = 0; i < cur->numNeighbors; i++)
         {
             neighbor = cur->neighbors[i];
-            if(neighbor->isVisited == 0)
+            if(!isVisited(graph, context, neighbor))
             {
                 if(neighbor == destination)
                 {
-                    /* free stack */
-                    dequeClear(stack);
-                    dequeDelete(stack);
                     return 1;
                 }
                 else
                 {
-                    neighbor->isVisited = 1;
-                    dequePushFront(stack, neighbor);
+                    setVisited(graph, context, neighbor);
+                    stack[top++] = (uint32_t)(neighbor - vertexSet);
                   /*  printf("Push: %d\n", neighbor->label); For testing .*/
                 }
            }
         }
     }
-    dequeClear(stack);
-    dequeDelete(stack);
     return 0;
 }
 
@@ -177,216 +246,290 @@ int dfsIterative(Graph* graph, Vertex* source, Vertex* destination)
  * Determines if there is a path from the source to the destination using an
  * iterative breadth-first search starting at the source.
  * 
- * Remember to call clearVisited() before starting the search.
- * 
  * @param graph
  * @param source
  * @param destination
  * @return 1 if there is a path, 0 otherwise.
  */
 int bfsIterative(Graph* graph, Vertex* source, Vertex* destination)
+{
+    return bfsIterativeContext(graph, traversalDefaultContext(), source,
+                               destination);
+}
+
+/**
+ * Same as bfsIterative, but keeps all traversal state in the given context.
+ * The context's reset clears the visited set in constant time.
+ * @param graph
+ * @param context
+ * @param source
+ * @param destination
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int bfsIterativeContext(Graph* graph, TraversalContext* context,
+                        Vertex* source, Vertex* destination)
 {
     // FIXME: Implement
      /* NOTE: As noted on piazza, based on provided code, did not appear separate container described in lecture for reachable vertices was necessary in this implementation. */
-    clearVisited(graph);
+    traversalContextReset(context, graph->numVertices);
     
     if(source == destination)
     {
         return 1;
     }
     
-    /* Use queue */
-    Deque* queue = dequeNew();
-    assert(queue != 0);
+    /* Use queue of vertex indices. Each vertex is enqueued at most once,
+     * so the context's buffer holds the whole queue without wrapping. */
+    Vertex* vertexSet = graph->vertexSet;
+    uint32_t* queue = context->buffer;
+    int head = 0;
+    int tail = 0;
     /* Start at source */
-    dequePushBack(queue, source);
-    source->isVisited = 1;
+    queue[tail++] = (uint32_t)(source - vertexSet);
+    setVisited(graph, context, source);
     
-    while(!dequeIsEmpty(queue))
+    while(head < tail)
     {
-        Vertex* cur = dequeFront(queue);  
-        dequePopFront(queue);
+        Vertex* cur = &vertexSet[queue[head++]];
       /*  printf("pop: %d\n", cur->label); For testing */
-        cur->isVisited = 1;
         Vertex* neighbor;
         for(int i = 0; i < cur->numNeighbors; i++)
         {
             neighbor = cur->neighbors[i];
-            if(neighbor->isVisited == 0)
+            if(!isVisited(graph, context, neighbor))
             {
                 if(neighbor == destination)
                 {
-                    /* free stack */
-                    dequeClear(queue);
-                    dequeDelete(queue);
                     return 1;
                 }
                 else
                 {
-                    neighbor->isVisited = 1;
-                    dequePushBack(queue, neighbor);
+                    setVisited(graph, context, neighbor);
+                    queue[tail++] = (uint32_t)(neighbor - vertexSet);
                     /* printf("Push: %d\n", neighbor->label); for testing */
                 }
             }
         }
     }
-    dequeClear(queue);
-    dequeDelete(queue);
     
     return 0;
 }
 
-typedef struct Edge Edge;
-
-struct Edge
-{
-    int i;
-    int j;
-};
-
 /**
- * Generates a set of random unique edges of size numEdges sampled from the
- * set of all possible edges.
- * @param numVertices
- * @param numEdges
- * @return An array of numEdges edges.
+ * Expands one level of a bidirectional search. The level is
+ * buffer[begin, end) of the context. Unvisited neighbors join this side and
+ * are written starting at *next, moving by step, so the two sides can grow
+ * toward each other in one buffer. Stops adding vertices once the sides
+ * meet, but finishes the level to find the shortest connection.
+ * @param graph
+ * @param context
+ * @param begin
+ * @param end
+ * @param next Index the next vertex is written to, updated.
+ * @param step 1 to grow upward, -1 to grow downward.
+ * @param mine Visited set of the side being expanded.
+ * @param other Visited set of the other side.
+ * @return The shortest path length through this level, or -1 if the sides
+ *         did not meet.
  */
-Edge* randomEdges(int numVertices, int numEdges)
+static int expandLevel(Graph* graph, TraversalContext* context, int begin,
+                       int end, int* next, int step, VisitedSet* mine,
+                       VisitedSet* other)
 {
-    assert(numVertices > 0);
-    int maxEdges = numVertices * (numVertices - 1) / 2;
-    assert(numEdges >= 0);
-    assert(numEdges <= maxEdges);
-    
-    // Generate all possible edges
-    Edge* edges = malloc(sizeof(Edge) * maxEdges);
-    int k = 0;
-    for (int i = 0; i < numVertices; ++i)
+    uint32_t* buffer = context->buffer;
+    int* distances = context->distances;
+    int best = -1;
+    for (int q = begin; q < end; ++q)
     {
-        for (int j = i + 1; j < numVertices; ++j)
+        Vertex* cur = &graph->vertexSet[buffer[q]];
+        int distance = distances[buffer[q]] + 1;
+        for (int i = 0; i < cur->numNeighbors; ++i)
         {
-            edges[k].i = i;
-            edges[k].j = j;
-            ++k;
+            int neighbor = (int)(cur->neighbors[i] - graph->vertexSet);
+            if (visitedSetContains(mine, neighbor))
+            {
+                continue;
+            }
+            if (visitedSetContains(other, neighbor))
+            {
+                int length = distance + distances[neighbor];
+                if (best < 0 || length < best)
+                {
+                    best = length;
+                }
+            }
+            else if (best < 0)
+            {
+                visitedSetAdd(mine, neighbor);
+                distances[neighbor] = distance;
+                buffer[*next] = (uint32_t)neighbor;
+                *next += step;
+            }
         }
     }
+    return best;
+}
 
-    // Shuffle edges
-    for (int i = maxEdges - 1; i > 0; --i)
+/**
+ * Finds the length of a shortest path from the source to the destination
+ * with a bidirectional breadth-first search. Frontiers grow from both
+ * endpoints, always expanding the one with fewer vertices, and the search
+ * stops at the level where they meet. It explores two balls of about half
+ * the distance instead of one of the full distance, often orders of
+ * magnitude fewer vertices than bfsIterative.
+ * @param graph
+ * @param context
+ * @param source
+ * @param destination
+ * @return The number of edges on a shortest path, or -1 if there is none.
+ */
+int bfsPathLengthContext(Graph* graph, TraversalContext* context,
+                         Vertex* source, Vertex* destination)
+{
+    traversalContextReset(context, graph->numVertices);
+    if (source == destination)
     {
-        int j = rand() % (i + 1);
-        Edge temp = edges[i];
-        edges[i] = edges[j];
-        edges[j] = temp;
+        return 0;
     }
     
-    // Take only the number of edges needed
-    edges = realloc(edges, sizeof(Edge) * numEdges);
-    return edges;
+    /* The forward side is buffer[forwardBegin, forwardEnd) and grows up
+     * from 0, the backward side grows down from the end. The sides never
+     * share a vertex, so the numVertices + 1 slots always suffice. */
+    int s = (int)(source - graph->vertexSet);
+    int d = (int)(destination - graph->vertexSet);
+    uint32_t* buffer = context->buffer;
+    int forwardBegin = 0;
+    int forwardEnd = 1;
+    int backwardBegin = graph->numVertices;
+    int backwardEnd = graph->numVertices + 1;
+    buffer[forwardBegin] = (uint32_t)s;
+    buffer[backwardBegin] = (uint32_t)d;
+    visitedSetAdd(context->visited, s);
+    visitedSetAdd(context->reverseVisited, d);
+    context->distances[s] = 0;
+    context->distances[d] = 0;
+    
+    while (forwardBegin < forwardEnd && backwardBegin < backwardEnd)
+    {
+        int length;
+        if (forwardEnd - forwardBegin <= backwardEnd - backwardBegin)
+        {
+            int next = forwardEnd;
+            length = expandLevel(graph, context, forwardBegin, forwardEnd,
+                                 &next, 1, context->visited,
+                                 context->reverseVisited);
+            forwardBegin = forwardEnd;
+            forwardEnd = next;
+        }
+        else
+        {
+            int next = backwardBegin - 1;
+            length = expandLevel(graph, context, backwardBegin, backwardEnd,
+                                 &next, -1, context->reverseVisited,
+                                 context->visited);
+            backwardEnd = backwardBegin;
+            backwardBegin = next + 1;
+        }
+        if (length >= 0)
+        {
+            return length;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Same as bfsPathLengthContext, using the default context.
+ * @param graph
+ * @param source
+ * @param destination
+ * @return The number of edges on a shortest path, or -1 if there is none.
+ */
+int bfsPathLength(Graph* graph, Vertex* source, Vertex* destination)
+{
+    return bfsPathLengthContext(graph, traversalDefaultContext(), source,
+                                destination);
+}
+
+/**
+ * Determines if there is a path from the source to the destination using a
+ * bidirectional breadth-first search. Can be passed to graphQueryParallel.
+ * @param graph
+ * @param context
+ * @param source
+ * @param destination
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int bfsBidirectionalContext(Graph* graph, TraversalContext* context,
+                            Vertex* source, Vertex* destination)
+{
+    return bfsPathLengthContext(graph, context, source, destination) >= 0;
+}
+
+/**
+ * Same as bfsBidirectionalContext, using the default context.
+ * @param graph
+ * @param source
+ * @param destination
+ * @return 1 if there is a path, 0 otherwise.
+ */
+int bfsBidirectional(Graph* graph, Vertex* source, Vertex* destination)
+{
+    return bfsPathLength(graph, source, destination) >= 0;
+}
+
+/**
+ * Returns a generator seed drawn from rand(), so srand() still decides which
+ * random graph is generated.
+ * @return The seed.
+ */
+static uint64_t randSeed(void)
+{
+    uint64_t seed = (uint64_t)rand();
+    seed = (seed << 31) ^ (uint64_t)rand();
+    return (seed << 31) ^ (uint64_t)rand();
+}
+
+/**
+ * Generates a set of random unique edges of size numEdges sampled from the
+ * set of all possible edges. Takes O(numEdges) time and memory, see
+ * uniformEdges.
+ * @param numVertices
+ * @param numEdges
+ * @return An array of numEdges edges.
+ */
+GraphEdge* randomEdges(int numVertices, int numEdges)
+{
+    return uniformEdges(numVertices, numEdges, randSeed(), 1);
 }
 
 /**
  * Given a number of vertices and a number of edges, generates a graph
  * connecting random pairs of vertices. The edges are unique, and thus their is
  * a maximum number of edges allowed in proportion to the number of vertices.
- * numEdges must be in the interval [0, numVertices * (numVertices + 1) / 2].
+ * numEdges must be in the interval [0, numVertices * (numVertices - 1) / 2].
  * @param numVertices
  * @param numEdges
  * @return 
  */
 Graph* randomGraph(int numVertices, int numEdges)
 {
-    assert(numVertices > 0);
-    assert(numEdges >= 0);
-    assert(numEdges <= numVertices * (numVertices - 1) / 2);
-    
-    Graph* graph = malloc(sizeof(Graph));
-    graph->numVertices = numVertices;
-    graph->numEdges = numEdges;
-    graph->vertexSet = malloc(sizeof(Vertex) * numVertices);
-    
-    // Initialize vertices
-    for (int i = 0; i < graph->numVertices; ++i)
-    {
-        Vertex* vertex = &graph->vertexSet[i];
-        vertex->label = i;
-        vertex->isVisited = 0;
-        vertex->numNeighbors = 0;
-        vertex->neighbors = NULL;
-    }
-    
-    // Randomly connect vertices
-    Edge* edges = randomEdges(numVertices, numEdges);
-    for (int i = 0; i < numEdges; ++i)
-    {
-        Vertex* v1 = &graph->vertexSet[edges[i].i];
-        Vertex* v2 = &graph->vertexSet[edges[i].j];
-        createEdge(v1, v2);
-    }
-    free(edges);
-
-    return graph;
+    return randomGraphSeeded(numVertices, numEdges, randSeed(), 1);
 }
 
 /**
  * Loads a graph from the given file. The file's first line must be the number
  * of vertices in the graph and each consecutive line must be a list of numbers
  * separated by spaces. The first number is the next vertex and the following
- * numbers are its neighbors.
+ * numbers are its neighbors. Parses the file on all online processors, see
+ * loadGraphParallel.
  * @param fileName
- * @return 
+ * @return The graph, or NULL if the file cannot be read.
  */
 Graph* loadGraph(const char* fileName)
 {
-    FILE* file = fopen(fileName, "r");
-    char buffer[512];
-    
-    // Get the number of vertices
-    fgets(buffer, sizeof buffer, file);
-    int numVertices = (int) strtol(buffer, NULL, 10);
-    Graph* graph = malloc(sizeof(Graph));
-    graph->numVertices = numVertices;
-    graph->numEdges = 0;
-    
-    // Initialize vertices
-    graph->vertexSet = malloc(sizeof(Vertex) * numVertices);
-    for (int i = 0; i < numVertices; ++i)
-    {
-        Vertex* vertex = &graph->vertexSet[i];
-        vertex->isVisited = 0;
-        vertex->label = i;
-        vertex->neighbors = NULL;
-        vertex->numNeighbors = 0;
-    }
-    
-    // Create edges
-    while (fgets(buffer, sizeof buffer, file) != NULL)
-    {
-        char* begin = buffer;
-        char* end = NULL;
-        
-        // Get vertex
-        int i = (int) strtol(begin, &end, 10);
-        Vertex* vertex = &graph->vertexSet[i];
-        begin = end;
-        
-        // Create edges
-        for (int i = (int) strtol(begin, &end, 10);
-            end != begin;
-            i = (int) strtol(begin, &end, 10))
-        {
-            Vertex* neighbor = &graph->vertexSet[i];
-            if (!isAdjacent(vertex, neighbor))
-            {
-                createEdge(vertex, neighbor);
-                ++(graph->numEdges);
-            }
-            begin = end;
-        }
-    }
-    fclose(file);
-    
-    return graph;
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    return loadGraphParallel(fileName, numThreads > 0 ? (int)numThreads : 1);
 }
 
 /**
@@ -404,21 +547,75 @@ void freeGraph(Graph* graph)
 }
 
 /**
- * Prints the vertex count, edge count, and adjacency list for each vertex.
+ * Writes the graph in the writer's format. Text is the printGraph layout, CSV
+ * writes a vertex,neighbor row per adjacency entry, and binary writes the
+ * vertex and edge counts followed by each vertex's degree and neighbors.
  * @param graph
+ * @param writer
  */
-void printGraph(Graph* graph)
+void graphReport(Graph* graph, ReportWriter* writer)
 {
-    printf("Vertex count: %d\n", graph->numVertices);
-    printf("Edge count: %d\n", graph->numEdges);
+    ReportFormat format = reportFormat(writer);
+    if (format == REPORT_TEXT)
+    {
+        reportWriteString(writer, "Vertex count: ");
+        reportWriteInt(writer, graph->numVertices);
+        reportWriteString(writer, "\nEdge count: ");
+        reportWriteInt(writer, graph->numEdges);
+        reportWriteChar(writer, '\n');
+    }
+    else if (format == REPORT_CSV)
+    {
+        reportWriteString(writer, "vertex,neighbor\n");
+    }
+    else
+    {
+        reportWriteBinaryInt(writer, graph->numVertices);
+        reportWriteBinaryInt(writer, graph->numEdges);
+    }
+    
     for (int i = 0; i < graph->numVertices; ++i)
     {
         Vertex* vertex = &graph->vertexSet[i];
-        printf("%d :", vertex->label);
-        for (int j = 0; j < vertex->numNeighbors; ++j)
+        if (format == REPORT_TEXT)
+        {
+            reportWriteInt(writer, vertex->label);
+            reportWriteString(writer, " :");
+            for (int j = 0; j < vertex->numNeighbors; ++j)
+            {
+                reportWriteChar(writer, ' ');
+                reportWriteInt(writer, vertex->neighbors[j]->label);
+            }
+            reportWriteChar(writer, '\n');
+        }
+        else if (format == REPORT_CSV)
+        {
+            for (int j = 0; j < vertex->numNeighbors; ++j)
+            {
+                reportWriteInt(writer, vertex->label);
+                reportWriteChar(writer, ',');
+                reportWriteInt(writer, vertex->neighbors[j]->label);
+                reportWriteChar(writer, '\n');
+            }
+        }
+        else
         {
-            printf(" %d", vertex->neighbors[j]->label);
+            reportWriteBinaryInt(writer, vertex->numNeighbors);
+            for (int j = 0; j < vertex->numNeighbors; ++j)
+            {
+                reportWriteBinaryInt(writer, vertex->neighbors[j]->label);
+            }
         }
-        printf("\n");
     }
+}
+
+/**
+ * Prints the vertex count, edge count, and adjacency list for each vertex.
+ * @param graph
+ */
+void printGraph(Graph* graph)
+{
+    ReportWriter* writer = reportWriterNew(stdout, REPORT_TEXT);
+    graphReport(graph, writer);
+    reportWriterDelete(writer);
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Main file for the text to binary graph converter.
+ */
+
+#include "graphLoader.h"
+#include "csrGraph.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Converts a graph in the text format read by loadGraph to the binary format
+ * read by csrMap. Usage: graphConvert [-t threads] input output. The option
+ * -t n loads the text with n threads (default: one per core).
+ * @param argc
+ * @param argv
+ * @return
+ */
+int main(int argc, const char** argv)
+{
+    const char* inputName = NULL;
+    const char* outputName = NULL;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            numThreads = (int) strtol(argv[++i], NULL, 10);
+        }
+        else if (inputName == NULL)
+        {
+            inputName = argv[i];
+        }
+        else
+        {
+            outputName = argv[i];
+        }
+    }
+    if (inputName == NULL || outputName == NULL)
+    {
+        printf("Usage: %s [-t threads] input output\n", argv[0]);
+        return 1;
+    }
+    if (numThreads < 1)
+    {
+        numThreads = 1;
+    }
+
+    clock_t timer = clock();
+    Graph* graph = loadGraphParallel(inputName, numThreads);
+    if (graph == NULL)
+    {
+        printf("Could not read graph: %s\n", inputName);
+        return 1;
+    }
+    CsrGraph* csr = csrFromGraph(graph);
+    freeGraph(graph);
+    int saved = csrSave(csr, outputName);
+    if (!saved)
+    {
+        printf("Could not write graph: %s\n", outputName);
+    }
+    else
+    {
+        timer = clock() - timer;
+        printf("Vertices: %d\n", csr->numVertices);
+        printf("Edges: %d\n", csr->numEdges);
+        printf("Converted in %f seconds\n",
+               (float)timer / (float)CLOCKS_PER_SEC);
+    }
+    csrDelete(csr);
+    return saved ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Graph functions that change a graph after it is built.
+ */
+
+#ifndef GRAPH_EDIT_H
+#define GRAPH_EDIT_H
+
+#include "graph.h"
+#include "componentIndex.h"
+
+void graphAddEdge(Graph* graph, ComponentIndex* index, int u, int v);
+
+#endif
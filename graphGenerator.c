@@ -0,0 +1,853 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Graph generator implementation file.
+ *
+ * Random numbers come from a counter-based generator: the k-th draw is a
+ * hash of the seed and k, with no state carried between draws. Any thread
+ * can compute any draw, so work is split across threads without changing
+ * the result, and a seed always produces the same graph.
+ */
+
+#include "graphGenerator.h"
+#include "adjacency.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <math.h>
+
+/* Items a thread claims at a time in parallelFor. */
+#define PARALLEL_CHUNK 4096
+
+/**
+ * SplitMix64 finalizer, a bijective 64-bit mix.
+ * @param x
+ * @return The mixed value.
+ */
+static inline uint64_t mix64(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Returns the counter-th random 64-bit value of the stream for a seed.
+ * @param seed
+ * @param counter
+ * @return Random value.
+ */
+static inline uint64_t randomAt(uint64_t seed, uint64_t counter)
+{
+    return mix64(seed + (counter + 1) * 0x9e3779b97f4a7c15ull);
+}
+
+/**
+ * Maps 32 random bits to [0, range) without division.
+ * @param bits
+ * @param range
+ * @return Value in [0, range).
+ */
+static inline uint32_t randomBelow(uint32_t bits, uint32_t range)
+{
+    return (uint32_t)(((uint64_t)bits * range) >> 32);
+}
+
+typedef struct EdgeSet EdgeSet;
+
+/**
+ * Open-addressing set of edge keys u * numVertices + v with u < v, stored as
+ * key + 1 so that 0 marks an empty slot. At most half full.
+ */
+struct EdgeSet
+{
+    uint64_t* slots;
+    uint64_t mask;
+};
+
+static void edgeSetInit(EdgeSet* set, long long maxSize)
+{
+    uint64_t capacity = 16;
+    while (capacity < 2 * (uint64_t)maxSize)
+    {
+        capacity *= 2;
+    }
+    set->slots = calloc(capacity, sizeof(uint64_t));
+    assert(set->slots != 0);
+    set->mask = capacity - 1;
+}
+
+/**
+ * Adds a key to the set.
+ * @param set
+ * @param key
+ * @return 1 if it was added, 0 if it was already in the set.
+ */
+static int edgeSetAdd(EdgeSet* set, uint64_t key)
+{
+    uint64_t slot = mix64(key) & set->mask;
+    while (set->slots[slot] != 0)
+    {
+        if (set->slots[slot] == key + 1)
+        {
+            return 0;
+        }
+        slot = (slot + 1) & set->mask;
+    }
+    set->slots[slot] = key + 1;
+    return 1;
+}
+
+static int edgeSetContains(EdgeSet* set, uint64_t key)
+{
+    for (uint64_t slot = mix64(key) & set->mask; set->slots[slot] != 0;
+         slot = (slot + 1) & set->mask)
+    {
+        if (set->slots[slot] == key + 1)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+typedef void (*RangeFunction)(void* context, long long begin,
+                              long long end);
+typedef struct ParallelLoop ParallelLoop;
+
+/**
+ * A loop over [0, count) shared by the threads running it, which claim
+ * chunks of it through next.
+ */
+struct ParallelLoop
+{
+    RangeFunction body;
+    void* context;
+    long long count;
+    long long next;
+};
+
+static void* parallelRun(void* arg)
+{
+    ParallelLoop* loop = arg;
+    long long begin;
+    while ((begin = __sync_fetch_and_add(&loop->next, PARALLEL_CHUNK))
+           < loop->count)
+    {
+        long long end = begin + PARALLEL_CHUNK;
+        loop->body(loop->context, begin, end < loop->count ? end
+                                                           : loop->count);
+    }
+    return NULL;
+}
+
+/**
+ * Calls body on chunks covering [0, count), using up to numThreads threads.
+ * The body must give the same results whichever thread runs a chunk.
+ * @param count
+ * @param numThreads
+ * @param body
+ * @param context Passed to body.
+ */
+static void parallelFor(long long count, int numThreads, RangeFunction body,
+                        void* context)
+{
+    ParallelLoop loop = {body, context, count, 0};
+    pthread_t* threads = malloc(sizeof(pthread_t) * numThreads);
+    assert(threads != 0);
+    /* Threads claim chunks as they go, so if some fail to start the others
+     * do their share. */
+    int started = 1;
+    while (started < numThreads &&
+           pthread_create(&threads[started], NULL, parallelRun, &loop) == 0)
+    {
+        ++started;
+    }
+    parallelRun(&loop);
+    for (int t = 1; t < started; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+}
+
+typedef struct DrawTask DrawTask;
+
+/**
+ * Candidate draws first to first + count of uniformEdges.
+ */
+struct DrawTask
+{
+    uint64_t seed;
+    uint32_t numVertices;
+    uint64_t first;
+    int count;
+    uint64_t* keys;
+};
+
+/**
+ * Returns the candidate edge key of a draw: a uniform ordered pair of
+ * distinct vertices, as an unordered key, or UINT64_MAX for a loop, which
+ * is rejected.
+ * @param seed
+ * @param counter
+ * @param numVertices
+ * @return The key or UINT64_MAX.
+ */
+static inline uint64_t drawKey(uint64_t seed, uint64_t counter,
+                               uint32_t numVertices)
+{
+    uint64_t bits = randomAt(seed, counter);
+    uint32_t u = randomBelow((uint32_t)bits, numVertices);
+    uint32_t v = randomBelow((uint32_t)(bits >> 32), numVertices);
+    if (u == v)
+    {
+        return UINT64_MAX;
+    }
+    if (u > v)
+    {
+        uint32_t temp = u;
+        u = v;
+        v = temp;
+    }
+    return (uint64_t)u * numVertices + v;
+}
+
+static void drawRange(void* context, long long begin, long long end)
+{
+    DrawTask* task = context;
+    for (long long i = begin; i < end; ++i)
+    {
+        task->keys[i] = drawKey(task->seed, task->first + (uint64_t)i,
+                                task->numVertices);
+    }
+}
+
+/**
+ * Samples numEdges distinct edges uniformly from all possible edges, in
+ * O(numEdges) expected time and memory. The result depends only on the
+ * seed, not on numThreads. Sparse requests draw random pairs and reject
+ * repeats with a hash set. Requests for more than half of all edges pick
+ * the edges to leave out instead, then list the rest.
+ * @param numVertices
+ * @param numEdges In [0, numVertices * (numVertices - 1) / 2].
+ * @param seed
+ * @param numThreads Number of threads drawing candidates, at least 1.
+ * @return An array of numEdges edges with u < v.
+ */
+GraphEdge* uniformEdges(int numVertices, int numEdges, uint64_t seed,
+                        int numThreads)
+{
+    assert(numVertices > 0);
+    assert(numThreads > 0);
+    long long maxEdges = (long long)numVertices * (numVertices - 1) / 2;
+    assert(numEdges >= 0);
+    assert(numEdges <= maxEdges);
+
+    int complement = numEdges > maxEdges / 2;
+    long long numSampled = complement ? maxEdges - numEdges : numEdges;
+    GraphEdge* edges = malloc(sizeof(GraphEdge) * ((size_t)numEdges + 1));
+    assert(edges != 0);
+    EdgeSet set;
+    edgeSetInit(&set, numSampled);
+
+    /* Draw batches of candidates in parallel and take the new ones in draw
+     * order, so the sample is the same for any thread count. */
+    DrawTask task;
+    task.seed = seed;
+    task.numVertices = (uint32_t)numVertices;
+    task.first = 0;
+    task.keys = NULL;
+    long long sampled = 0;
+    while (sampled < numSampled)
+    {
+        long long missing = numSampled - sampled;
+        long long batch = missing + missing / 4 + 64;
+        task.count = batch < (1 << 24) ? (int)batch : (1 << 24);
+        task.keys = realloc(task.keys, sizeof(uint64_t) * task.count);
+        assert(task.keys != 0);
+        parallelFor(task.count, numThreads, drawRange, &task);
+        for (int i = 0; i < task.count && sampled < numSampled; ++i)
+        {
+            uint64_t key = task.keys[i];
+            if (key != UINT64_MAX && edgeSetAdd(&set, key))
+            {
+                if (!complement)
+                {
+                    edges[sampled].u = (int)(key / (uint64_t)numVertices);
+                    edges[sampled].v = (int)(key % (uint64_t)numVertices);
+                }
+                ++sampled;
+            }
+        }
+        task.first += (uint64_t)task.count;
+    }
+    free(task.keys);
+
+    if (complement)
+    {
+        int k = 0;
+        for (int u = 0; u < numVertices; ++u)
+        {
+            for (int v = u + 1; v < numVertices; ++v)
+            {
+                uint64_t key = (uint64_t)u * numVertices + v;
+                if (!edgeSetContains(&set, key))
+                {
+                    edges[k].u = u;
+                    edges[k].v = v;
+                    ++k;
+                }
+            }
+        }
+        assert(k == numEdges);
+    }
+    free(set.slots);
+    return edges;
+}
+
+static int compareIndices(const void* a, const void* b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Builds a graph from a list of edges in O(numEdges log degree), without
+ * per-edge duplicate checks: each vertex's list is allocated once at its
+ * degree, then sorted and deduplicated. Loops are dropped.
+ * @param numVertices
+ * @param edges Edges with endpoints in [0, numVertices).
+ * @param numEdges
+ * @return The graph.
+ */
+Graph* graphFromEdges(int numVertices, const GraphEdge* edges, int numEdges)
+{
+    assert(numVertices >= 0 && numEdges >= 0);
+    long long* offsets = calloc((size_t)numVertices + 1, sizeof(long long));
+    assert(offsets != 0);
+    for (int i = 0; i < numEdges; ++i)
+    {
+        assert(edges[i].u >= 0 && edges[i].u < numVertices);
+        assert(edges[i].v >= 0 && edges[i].v < numVertices);
+        if (edges[i].u != edges[i].v)
+        {
+            ++offsets[edges[i].u + 1];
+            ++offsets[edges[i].v + 1];
+        }
+    }
+    for (int i = 0; i < numVertices; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    int* lists = malloc(sizeof(int) * ((size_t)offsets[numVertices] + 1));
+    long long* cursors = malloc(sizeof(long long) *
+                                ((size_t)numVertices + 1));
+    assert(lists != 0 && cursors != 0);
+    memcpy(cursors, offsets, sizeof(long long) * (size_t)numVertices);
+    for (int i = 0; i < numEdges; ++i)
+    {
+        if (edges[i].u != edges[i].v)
+        {
+            lists[cursors[edges[i].u]++] = edges[i].v;
+            lists[cursors[edges[i].v]++] = edges[i].u;
+        }
+    }
+    free(cursors);
+
+    Graph* graph = malloc(sizeof(Graph));
+    assert(graph != 0);
+    graph->numVertices = numVertices;
+    graph->vertexSet = malloc(sizeof(Vertex) * ((size_t)numVertices + 1));
+    assert(graph->vertexSet != 0);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        graph->vertexSet[i].label = i;
+    }
+    long long entries = 0;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        int* list = lists + offsets[i];
+        int count = (int)(offsets[i + 1] - offsets[i]);
+        qsort(list, (size_t)count, sizeof(int), compareIndices);
+        int unique = 0;
+        for (int j = 0; j < count; ++j)
+        {
+            if (unique == 0 || list[j] != list[unique - 1])
+            {
+                list[unique++] = list[j];
+            }
+        }
+        Vertex* vertex = &graph->vertexSet[i];
+        adjacencyAllocate(vertex, unique);
+        for (int j = 0; j < unique; ++j)
+        {
+            vertex->neighbors[j] = &graph->vertexSet[list[j]];
+        }
+        adjacencyIndex(vertex);
+        entries += unique;
+    }
+    graph->numEdges = (int)(entries / 2);
+    free(lists);
+    free(offsets);
+    return graph;
+}
+
+/**
+ * Generates a graph of numEdges distinct edges chosen uniformly at random,
+ * in O(numVertices + numEdges) expected time and memory. The same seed
+ * always gives the same graph, whatever numThreads is.
+ * @param numVertices
+ * @param numEdges In [0, numVertices * (numVertices - 1) / 2].
+ * @param seed
+ * @param numThreads Number of threads, at least 1.
+ * @return The graph.
+ */
+Graph* randomGraphSeeded(int numVertices, int numEdges, uint64_t seed,
+                         int numThreads)
+{
+    GraphEdge* edges = uniformEdges(numVertices, numEdges, seed, numThreads);
+    Graph* graph = graphFromEdges(numVertices, edges, numEdges);
+    free(edges);
+    return graph;
+}
+
+/**
+ * Returns a uniform double in [0, 1) from 64 random bits.
+ * @param bits
+ * @return Value in [0, 1).
+ */
+static inline double unitDouble(uint64_t bits)
+{
+    return (double)(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Returns a random permutation of [0, n) for the seed.
+ * @param n
+ * @param seed
+ * @return Array of n distinct indices.
+ */
+static int* randomPermutation(int n, uint64_t seed)
+{
+    int* permutation = malloc(sizeof(int) * ((size_t)n + 1));
+    assert(permutation != 0);
+    for (int i = 0; i < n; ++i)
+    {
+        permutation[i] = i;
+    }
+    for (int i = n - 1; i > 0; --i)
+    {
+        int j = (int)randomBelow((uint32_t)randomAt(seed, (uint64_t)i),
+                                 (uint32_t)i + 1);
+        int temp = permutation[i];
+        permutation[i] = permutation[j];
+        permutation[j] = temp;
+    }
+    return permutation;
+}
+
+typedef struct RmatTask RmatTask;
+
+/**
+ * Parameters of rmatEdges. Quadrant thresholds are scaled to 16 bits.
+ */
+struct RmatTask
+{
+    uint64_t seed;
+    int scale;
+    uint32_t a;
+    uint32_t ab;
+    uint32_t abc;
+    const int* permutation;
+    GraphEdge* edges;
+};
+
+static void rmatRange(void* context, long long begin, long long end)
+{
+    RmatTask* task = context;
+    int drawsPerEdge = (task->scale + 3) / 4;
+    for (long long e = begin; e < end; ++e)
+    {
+        /* Each level picks a quadrant of the adjacency matrix with 16
+         * random bits, four levels per 64-bit draw. */
+        uint32_t u = 0;
+        uint32_t v = 0;
+        uint64_t bits = 0;
+        for (int level = 0; level < task->scale; ++level)
+        {
+            if (level % 4 == 0)
+            {
+                bits = randomAt(task->seed,
+                                (uint64_t)e * drawsPerEdge + level / 4);
+            }
+            uint32_t r = (uint32_t)(bits & 0xffff);
+            bits >>= 16;
+            u <<= 1;
+            v <<= 1;
+            if (r >= task->abc)
+            {
+                u |= 1;
+                v |= 1;
+            }
+            else if (r >= task->ab)
+            {
+                u |= 1;
+            }
+            else if (r >= task->a)
+            {
+                v |= 1;
+            }
+        }
+        task->edges[e].u = task->permutation[u];
+        task->edges[e].v = task->permutation[v];
+    }
+}
+
+/**
+ * Generates edges of a Recursive MATrix (R-MAT) graph on 2^scale vertices,
+ * the Kronecker generator of the Graph500 benchmark. Each edge descends
+ * scale levels of the adjacency matrix, choosing the top left, top right,
+ * bottom left or bottom right quadrant with probabilities a, b, c and
+ * 1 - a - b - c. Skewed probabilities give power-law degrees with a few
+ * large hubs. Vertex numbers are then randomly permuted, so hubs are not all
+ * at low indices. Edges may repeat or be loops; graphFromEdges and
+ * csrFromEdges drop them. Graph500 uses a = 0.57 and b = c = 0.19.
+ * @param scale log2 of the number of vertices, in [1, 30].
+ * @param numEdges Number of edges to draw, 16 << scale in Graph500.
+ * @param a
+ * @param b
+ * @param c
+ * @param seed
+ * @param numThreads Number of threads, at least 1.
+ * @return An array of numEdges edges.
+ */
+GraphEdge* rmatEdges(int scale, int numEdges, double a, double b, double c,
+                     uint64_t seed, int numThreads)
+{
+    assert(scale >= 1 && scale <= 30);
+    assert(numEdges >= 0 && numThreads > 0);
+    assert(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1);
+    RmatTask task;
+    task.seed = seed;
+    task.scale = scale;
+    task.a = (uint32_t)(a * 65536);
+    task.ab = (uint32_t)((a + b) * 65536);
+    task.abc = (uint32_t)((a + b + c) * 65536);
+    task.permutation = randomPermutation(1 << scale, mix64(seed ^ 1));
+    task.edges = malloc(sizeof(GraphEdge) * ((size_t)numEdges + 1));
+    assert(task.edges != 0);
+    parallelFor(numEdges, numThreads, rmatRange, &task);
+    free((int*)task.permutation);
+    return task.edges;
+}
+
+/* Rows of the adjacency matrix per gnpEdges work item. Fixed, so the
+ * result does not depend on the number of threads. */
+#define GNP_ROW_BLOCK 64
+
+typedef struct GnpTask GnpTask;
+
+/**
+ * Parameters and per-block output of gnpEdges.
+ */
+struct GnpTask
+{
+    uint64_t seed;
+    int numVertices;
+    double p;
+    double logSkip;
+    GraphEdge** blockEdges;
+    long long* blockSizes;
+};
+
+static void gnpRange(void* context, long long begin, long long end)
+{
+    GnpTask* task = context;
+    for (long long block = begin; block < end; ++block)
+    {
+        long long capacity = 16;
+        long long size = 0;
+        GraphEdge* edges = malloc(sizeof(GraphEdge) * capacity);
+        assert(edges != 0);
+        int first = (int)(block * GNP_ROW_BLOCK);
+        int last = first + GNP_ROW_BLOCK < task->numVertices
+                   ? first + GNP_ROW_BLOCK : task->numVertices;
+        for (int u = first; u < last; ++u)
+        {
+            /* Jump straight to the next edge of row u: the gap to it is
+             * geometric, so the row costs O(1 + its degree). */
+            uint64_t rowSeed = mix64(task->seed ^ ((uint64_t)u << 1));
+            uint64_t draw = 0;
+            long long v = u;
+            while (1)
+            {
+                if (task->p < 1)
+                {
+                    double r = unitDouble(randomAt(rowSeed, draw++));
+                    double skip = log1p(-r) / task->logSkip;
+                    /* A tiny p makes the skip too large to convert, and
+                     * any skip past the row ends it anyway. */
+                    v += 1 + (skip < task->numVertices
+                              ? (long long)skip : task->numVertices);
+                }
+                else
+                {
+                    ++v;
+                }
+                if (v >= task->numVertices)
+                {
+                    break;
+                }
+                if (size == capacity)
+                {
+                    capacity *= 2;
+                    edges = realloc(edges, sizeof(GraphEdge) * capacity);
+                    assert(edges != 0);
+                }
+                edges[size].u = u;
+                edges[size].v = (int)v;
+                ++size;
+            }
+        }
+        task->blockEdges[block] = edges;
+        task->blockSizes[block] = size;
+    }
+}
+
+/**
+ * Generates an Erdos-Renyi G(n, p) graph's edges: each of the
+ * n * (n - 1) / 2 possible edges independently with probability p. Instead
+ * of a coin flip per pair, the gap to the next edge is drawn from the
+ * geometric distribution, so the time is O(n + edges) rather than O(n^2).
+ * @param numVertices
+ * @param p Edge probability in [0, 1].
+ * @param seed
+ * @param numThreads Number of threads, at least 1.
+ * @param numEdges Set to the number of edges generated.
+ * @return An array of *numEdges edges with u < v.
+ */
+GraphEdge* gnpEdges(int numVertices, double p, uint64_t seed, int numThreads,
+                    int* numEdges)
+{
+    assert(numVertices > 0 && numThreads > 0);
+    assert(p >= 0 && p <= 1);
+    long long numBlocks = (numVertices + GNP_ROW_BLOCK - 1) / GNP_ROW_BLOCK;
+    GnpTask task;
+    task.seed = seed;
+    task.numVertices = numVertices;
+    task.p = p;
+    task.logSkip = log1p(-p);
+    task.blockEdges = malloc(sizeof(GraphEdge*) * numBlocks);
+    task.blockSizes = malloc(sizeof(long long) * numBlocks);
+    assert(task.blockEdges != 0 && task.blockSizes != 0);
+    if (p > 0)
+    {
+        parallelFor(numBlocks, numThreads, gnpRange, &task);
+    }
+    else
+    {
+        for (long long i = 0; i < numBlocks; ++i)
+        {
+            task.blockEdges[i] = NULL;
+            task.blockSizes[i] = 0;
+        }
+    }
+
+    /* Concatenate the blocks in row order. */
+    long long total = 0;
+    for (long long i = 0; i < numBlocks; ++i)
+    {
+        total += task.blockSizes[i];
+    }
+    assert(total <= INT32_MAX);
+    GraphEdge* edges = malloc(sizeof(GraphEdge) * ((size_t)total + 1));
+    assert(edges != 0);
+    long long k = 0;
+    for (long long i = 0; i < numBlocks; ++i)
+    {
+        if (task.blockSizes[i] > 0)
+        {
+            memcpy(edges + k, task.blockEdges[i],
+                   sizeof(GraphEdge) * task.blockSizes[i]);
+            k += task.blockSizes[i];
+        }
+        free(task.blockEdges[i]);
+    }
+    free(task.blockEdges);
+    free(task.blockSizes);
+    *numEdges = (int)total;
+    return edges;
+}
+
+typedef struct ChungLuTask ChungLuTask;
+
+/**
+ * Parameters of chungLuEdges. cumulative[i] is the total weight of
+ * vertices 0 to i.
+ */
+struct ChungLuTask
+{
+    uint64_t seed;
+    int numVertices;
+    const double* cumulative;
+    GraphEdge* edges;
+};
+
+/**
+ * Returns the vertex whose cumulative weight interval holds x.
+ * @param task
+ * @param x In [0, total weight).
+ * @return Vertex index.
+ */
+static int weightedVertex(ChungLuTask* task, double x)
+{
+    int low = 0;
+    int high = task->numVertices - 1;
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if (task->cumulative[middle] <= x)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void chungLuRange(void* context, long long begin, long long end)
+{
+    ChungLuTask* task = context;
+    double total = task->cumulative[task->numVertices - 1];
+    for (long long e = begin; e < end; ++e)
+    {
+        uint64_t bits = randomAt(task->seed, (uint64_t)e * 2);
+        task->edges[e].u = weightedVertex(task, unitDouble(bits) * total);
+        bits = randomAt(task->seed, (uint64_t)e * 2 + 1);
+        task->edges[e].v = weightedVertex(task, unitDouble(bits) * total);
+    }
+}
+
+/**
+ * Generates the edges of a Chung-Lu graph with power-law expected degrees.
+ * Vertex i gets weight (i + 1)^(-1 / (exponent - 1)), scaled so the weights
+ * average averageDegree, and both endpoints of every edge are drawn in
+ * proportion to weight. Vertex i's expected degree is then close to its
+ * weight, and the degree distribution follows a power law with the given
+ * exponent; vertex 0 is the largest hub. Edges may repeat or be loops;
+ * graphFromEdges and csrFromEdges drop them, which trims the hubs slightly.
+ * @param numVertices
+ * @param averageDegree
+ * @param exponent Power-law exponent, greater than 2; 2.1 to 3 is typical.
+ * @param seed
+ * @param numThreads Number of threads, at least 1.
+ * @param numEdges Set to the number of edges generated.
+ * @return An array of *numEdges edges.
+ */
+GraphEdge* chungLuEdges(int numVertices, double averageDegree,
+                        double exponent, uint64_t seed, int numThreads,
+                        int* numEdges)
+{
+    assert(numVertices > 0 && numThreads > 0);
+    assert(averageDegree >= 0 && exponent > 2);
+    double* cumulative = malloc(sizeof(double) * numVertices);
+    assert(cumulative != 0);
+    double total = 0;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        total += pow(i + 1.0, -1.0 / (exponent - 1.0));
+        cumulative[i] = total;
+    }
+    double count = (double)numVertices * averageDegree / 2;
+    assert(count <= INT32_MAX);
+
+    ChungLuTask task;
+    task.seed = seed;
+    task.numVertices = numVertices;
+    task.cumulative = cumulative;
+    *numEdges = (int)(count + 0.5);
+    task.edges = malloc(sizeof(GraphEdge) * ((size_t)*numEdges + 1));
+    assert(task.edges != 0);
+    parallelFor(*numEdges, numThreads, chungLuRange, &task);
+    free(cumulative);
+    return task.edges;
+}
+
+/**
+ * Builds a CSR graph from a list of edges, with the same rules as
+ * graphFromEdges: every list is sorted, and loops and repeated edges are
+ * dropped.
+ * @param numVertices
+ * @param edges Edges with endpoints in [0, numVertices).
+ * @param numEdges
+ * @return The CSR graph.
+ */
+CsrGraph* csrFromEdges(int numVertices, const GraphEdge* edges, int numEdges)
+{
+    assert(numVertices >= 0 && numEdges >= 0);
+    uint64_t* offsets = calloc((size_t)numVertices + 1, sizeof(uint64_t));
+    assert(offsets != 0);
+    for (int i = 0; i < numEdges; ++i)
+    {
+        assert(edges[i].u >= 0 && edges[i].u < numVertices);
+        assert(edges[i].v >= 0 && edges[i].v < numVertices);
+        if (edges[i].u != edges[i].v)
+        {
+            ++offsets[edges[i].u + 1];
+            ++offsets[edges[i].v + 1];
+        }
+    }
+    for (int i = 0; i < numVertices; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    uint32_t* neighbors = malloc(sizeof(uint32_t) *
+                                 ((size_t)offsets[numVertices] + 1));
+    uint64_t* cursors = malloc(sizeof(uint64_t) * ((size_t)numVertices + 1));
+    assert(neighbors != 0 && cursors != 0);
+    memcpy(cursors, offsets, sizeof(uint64_t) * (size_t)numVertices);
+    for (int i = 0; i < numEdges; ++i)
+    {
+        if (edges[i].u != edges[i].v)
+        {
+            neighbors[cursors[edges[i].u]++] = (uint32_t)edges[i].v;
+            neighbors[cursors[edges[i].v]++] = (uint32_t)edges[i].u;
+        }
+    }
+    free(cursors);
+
+    /* Sort and deduplicate each list, compacting them toward the front. */
+    uint64_t out = 0;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        uint32_t* list = neighbors + offsets[i];
+        size_t count = (size_t)(offsets[i + 1] - offsets[i]);
+        qsort(list, count, sizeof(uint32_t), compareIndices);
+        offsets[i] = out;
+        for (size_t j = 0; j < count; ++j)
+        {
+            if (out == offsets[i] || list[j] != neighbors[out - 1])
+            {
+                neighbors[out++] = list[j];
+            }
+        }
+    }
+    offsets[numVertices] = out;
+
+    CsrGraph* csr = malloc(sizeof(CsrGraph));
+    assert(csr != 0);
+    csr->numVertices = numVertices;
+    csr->numEdges = (int)(out / 2);
+    csr->offsets = offsets;
+    csr->neighbors = neighbors;
+    csr->image = NULL;
+    csr->imageSize = 0;
+    csr->isMapped = 0;
+    return csr;
+}
@@ -0,0 +1,40 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Seeded random graph generators.
+ */
+
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include "graph.h"
+#include "csrGraph.h"
+#include <stdint.h>
+
+typedef struct GraphEdge GraphEdge;
+
+/**
+ * An undirected edge between the vertices with indices u and v.
+ */
+struct GraphEdge
+{
+    int u;
+    int v;
+};
+
+GraphEdge* uniformEdges(int numVertices, int numEdges, uint64_t seed,
+                        int numThreads);
+GraphEdge* rmatEdges(int scale, int numEdges, double a, double b, double c,
+                     uint64_t seed, int numThreads);
+GraphEdge* gnpEdges(int numVertices, double p, uint64_t seed, int numThreads,
+                    int* numEdges);
+GraphEdge* chungLuEdges(int numVertices, double averageDegree,
+                        double exponent, uint64_t seed, int numThreads,
+                        int* numEdges);
+
+Graph* graphFromEdges(int numVertices, const GraphEdge* edges, int numEdges);
+CsrGraph* csrFromEdges(int numVertices, const GraphEdge* edges, int numEdges);
+Graph* randomGraphSeeded(int numVertices, int numEdges, uint64_t seed,
+                         int numThreads);
+
+#endif
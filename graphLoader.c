@@ -0,0 +1,415 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Graph loader implementation file.
+ *
+ * The file is mapped into memory and split into chunks that start and end
+ * on line boundaries, so lines of any length are parsed in place by one
+ * thread each. Loading takes two passes over the text: the first counts
+ * every vertex's degree, so each adjacency list can be allocated once at
+ * its final size, and the second writes the neighbors into those lists.
+ * Duplicate edges are then removed by sorting each list.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include "graphLoader.h"
+#include "adjacency.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+typedef struct LoadTask LoadTask;
+typedef struct LoadWorker LoadWorker;
+
+/**
+ * State shared by the threads of one load. degrees[v] counts v's adjacency
+ * entries in the first pass. cursors[v] is the next free slot of v's list
+ * in adjacency during the second pass. Both are updated with atomic
+ * increments only if more than one thread is loading, since locked
+ * increments stall on every cache miss instead of overlapping them.
+ */
+struct LoadTask
+{
+    const char* text;
+    int numVertices;
+    uint64_t* degrees;
+    uint64_t* offsets;
+    uint64_t* cursors;
+    uint32_t* adjacency;
+    Graph* graph;
+    int numThreads;
+};
+
+/**
+ * A thread's text chunk [begin, end) and vertex range [first, last).
+ */
+struct LoadWorker
+{
+    LoadTask* task;
+    size_t begin;
+    size_t end;
+    int first;
+    int last;
+    uint64_t numEntries;
+};
+
+/**
+ * Reads the next unsigned integer on the current line.
+ * @param text
+ * @param pos Position to start from, moved past the number.
+ * @param end
+ * @param value Set to the number read.
+ * @return 1 if a number was read, 0 at the end of the line or chunk.
+ */
+static inline int nextNumber(const char* text, size_t* pos, size_t end,
+                             uint64_t* value)
+{
+    size_t i = *pos;
+    while (i < end && (text[i] < '0' || text[i] > '9'))
+    {
+        if (text[i] == '\n')
+        {
+            *pos = i;
+            return 0;
+        }
+        ++i;
+    }
+    if (i == end)
+    {
+        *pos = i;
+        return 0;
+    }
+    uint64_t number = 0;
+    while (i < end && text[i] >= '0' && text[i] <= '9')
+    {
+        /* Saturate, so absurdly long numbers fail the range check. */
+        if (number < UINT32_MAX)
+        {
+            number = number * 10 + (uint64_t)(text[i] - '0');
+        }
+        ++i;
+    }
+    *pos = i;
+    *value = number;
+    return 1;
+}
+
+/**
+ * Returns the counter's value and increments it, atomically if shared.
+ * @param counter
+ * @param shared
+ * @return The value before the increment.
+ */
+static inline uint64_t increment(uint64_t* counter, int shared)
+{
+    return shared ? __sync_fetch_and_add(counter, 1) : (*counter)++;
+}
+
+/**
+ * Parses the worker's chunk. In the first pass counts both endpoints of
+ * every edge, in the second writes them into the adjacency lists. Loops and
+ * vertices out of range are skipped.
+ * @param worker
+ * @param fill 0 for the counting pass, 1 for the filling pass.
+ */
+static void parseChunk(LoadWorker* worker, int fill)
+{
+    LoadTask* task = worker->task;
+    const char* text = task->text;
+    uint64_t numVertices = (uint64_t)task->numVertices;
+    int shared = task->numThreads > 1;
+    size_t pos = worker->begin;
+    while (pos < worker->end)
+    {
+        uint64_t vertex;
+        uint64_t neighbor;
+        if (nextNumber(text, &pos, worker->end, &vertex) &&
+            vertex < numVertices)
+        {
+            while (nextNumber(text, &pos, worker->end, &neighbor))
+            {
+                if (neighbor >= numVertices || neighbor == vertex)
+                {
+                    continue;
+                }
+                if (fill)
+                {
+                    uint64_t i = increment(&task->cursors[vertex], shared);
+                    uint64_t j = increment(&task->cursors[neighbor], shared);
+                    task->adjacency[i] = (uint32_t)neighbor;
+                    task->adjacency[j] = (uint32_t)vertex;
+                }
+                else
+                {
+                    increment(&task->degrees[vertex], shared);
+                    increment(&task->degrees[neighbor], shared);
+                }
+            }
+        }
+        /* Skip to the start of the next line. */
+        while (pos < worker->end && text[pos] != '\n')
+        {
+            ++pos;
+        }
+        ++pos;
+    }
+}
+
+static int compareIndices(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Sorts a list of vertex indices. Most lists are short, and insertion sort
+ * beats qsort's per-comparison calls on them.
+ * @param list
+ * @param count
+ */
+static void sortIndices(uint32_t* list, uint64_t count)
+{
+    if (count > 32)
+    {
+        qsort(list, count, sizeof(uint32_t), compareIndices);
+        return;
+    }
+    for (uint64_t i = 1; i < count; ++i)
+    {
+        uint32_t value = list[i];
+        uint64_t j = i;
+        while (j > 0 && list[j - 1] > value)
+        {
+            list[j] = list[j - 1];
+            --j;
+        }
+        list[j] = value;
+    }
+}
+
+/**
+ * Sorts and deduplicates the adjacency lists of the worker's vertices and
+ * gives each vertex its own neighbors array, laid out by adjacencyAllocate.
+ * @param worker
+ */
+static void buildVertices(LoadWorker* worker)
+{
+    LoadTask* task = worker->task;
+    Graph* graph = task->graph;
+    uint64_t entries = 0;
+    for (int v = worker->first; v < worker->last; ++v)
+    {
+        uint32_t* list = task->adjacency + task->offsets[v];
+        uint64_t count = task->offsets[v + 1] - task->offsets[v];
+        sortIndices(list, count);
+        uint64_t unique = 0;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            if (unique == 0 || list[i] != list[unique - 1])
+            {
+                list[unique++] = list[i];
+            }
+        }
+
+        Vertex* vertex = &graph->vertexSet[v];
+        adjacencyAllocate(vertex, (int)unique);
+        for (uint64_t i = 0; i < unique; ++i)
+        {
+            vertex->neighbors[i] = &graph->vertexSet[list[i]];
+        }
+        adjacencyIndex(vertex);
+        entries += unique;
+    }
+    worker->numEntries = entries;
+}
+
+static void* countRun(void* arg)
+{
+    parseChunk(arg, 0);
+    return NULL;
+}
+
+static void* fillRun(void* arg)
+{
+    parseChunk(arg, 1);
+    return NULL;
+}
+
+static void* buildRun(void* arg)
+{
+    buildVertices(arg);
+    return NULL;
+}
+
+/**
+ * Runs the function once per worker, each on its own thread. A worker whose
+ * thread cannot be started is run on the calling thread.
+ * @param workers
+ * @param numThreads
+ * @param run
+ */
+static void runWorkers(LoadWorker* workers, int numThreads,
+                       void* (*run)(void*))
+{
+    pthread_t* threads = malloc(sizeof(pthread_t) * numThreads);
+    int* started = calloc(numThreads, sizeof(int));
+    assert(threads != 0 && started != 0);
+    for (int t = 1; t < numThreads; t++)
+    {
+        started[t] = pthread_create(&threads[t], NULL, run,
+                                    &workers[t]) == 0;
+    }
+    run(&workers[0]);
+    for (int t = 1; t < numThreads; t++)
+    {
+        if (started[t])
+        {
+            pthread_join(threads[t], NULL);
+        }
+        else
+        {
+            run(&workers[t]);
+        }
+    }
+    free(started);
+    free(threads);
+}
+
+/**
+ * Loads a graph in the format read by loadGraph: the number of vertices on
+ * the first line, then lines of a vertex followed by its neighbors. Lines
+ * may be of any length. An edge may be listed from either endpoint or
+ * both, and is added once. Loops and vertex numbers out of range are
+ * ignored. Each vertex's neighbors are in increasing order.
+ * @param fileName
+ * @param numThreads Number of worker threads, at least 1.
+ * @return The graph, or NULL if the file cannot be read.
+ */
+Graph* loadGraphParallel(const char* fileName, int numThreads)
+{
+    assert(numThreads > 0);
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    const char* text = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (text == MAP_FAILED)
+    {
+        return NULL;
+    }
+    madvise((void*)text, size, MADV_SEQUENTIAL);
+
+    // Get the number of vertices
+    size_t pos = 0;
+    uint64_t numVertices = 0;
+    if (!nextNumber(text, &pos, size, &numVertices) ||
+        numVertices > INT32_MAX)
+    {
+        munmap((void*)text, size);
+        return NULL;
+    }
+    while (pos < size && text[pos] != '\n')
+    {
+        ++pos;
+    }
+
+    LoadTask task;
+    task.text = text;
+    task.numVertices = (int)numVertices;
+    task.numThreads = numThreads;
+    task.degrees = calloc(numVertices + 1, sizeof(uint64_t));
+    task.offsets = malloc(sizeof(uint64_t) * (numVertices + 1));
+    task.cursors = malloc(sizeof(uint64_t) * (numVertices + 1));
+    assert(task.degrees != 0 && task.offsets != 0 && task.cursors != 0);
+
+    /* Split the text after the first line into chunks that each begin at
+     * the start of a line. */
+    LoadWorker* workers = malloc(sizeof(LoadWorker) * numThreads);
+    assert(workers != 0);
+    size_t begin = pos;
+    for (int t = 0; t < numThreads; t++)
+    {
+        size_t end = pos + (size - pos) / numThreads * (t + 1);
+        if (t == numThreads - 1)
+        {
+            end = size;
+        }
+        while (end < size && text[end - 1] != '\n')
+        {
+            ++end;
+        }
+        if (end < begin)
+        {
+            end = begin;
+        }
+        workers[t].task = &task;
+        workers[t].begin = begin;
+        workers[t].end = end;
+        workers[t].first = (int)(numVertices * t / numThreads);
+        workers[t].last = (int)(numVertices * (t + 1) / numThreads);
+        workers[t].numEntries = 0;
+        begin = end;
+    }
+
+    runWorkers(workers, numThreads, countRun);
+
+    uint64_t total = 0;
+    for (uint64_t v = 0; v < numVertices; ++v)
+    {
+        task.offsets[v] = total;
+        task.cursors[v] = total;
+        total += task.degrees[v];
+    }
+    task.offsets[numVertices] = total;
+    free(task.degrees);
+    task.adjacency = malloc(sizeof(uint32_t) * (total + 1));
+    assert(task.adjacency != 0);
+
+    runWorkers(workers, numThreads, fillRun);
+    munmap((void*)text, size);
+
+    Graph* graph = malloc(sizeof(Graph));
+    assert(graph != 0);
+    graph->numVertices = (int)numVertices;
+    graph->vertexSet = malloc(sizeof(Vertex) * (numVertices + 1));
+    assert(graph->vertexSet != 0);
+    task.graph = graph;
+
+    /* Hub lists hash their neighbors' labels, so set every label first. */
+    for (uint64_t v = 0; v < numVertices; ++v)
+    {
+        graph->vertexSet[v].label = (int)v;
+    }
+    runWorkers(workers, numThreads, buildRun);
+
+    uint64_t entries = 0;
+    for (int t = 0; t < numThreads; t++)
+    {
+        entries += workers[t].numEntries;
+    }
+    graph->numEdges = (int)(entries / 2);
+
+    free(task.adjacency);
+    free(task.offsets);
+    free(task.cursors);
+    free(workers);
+    return graph;
+}
@@ -0,0 +1,14 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Parallel loader for graph files.
+ */
+
+#ifndef GRAPH_LOADER_H
+#define GRAPH_LOADER_H
+
+#include "graph.h"
+
+Graph* loadGraphParallel(const char* fileName, int numThreads);
+
+#endif
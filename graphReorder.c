@@ -0,0 +1,357 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Graph reordering implementation file.
+ *
+ * A traversal touches the neighbors of each vertex it expands, so the cost
+ * of a step depends on how close together those neighbors sit in memory.
+ * Vertex numbers from a file or generator are usually scattered, and nearly
+ * every neighbor is a cache miss. The orders here renumber vertices so that
+ * vertices visited together are stored together:
+ *
+ *   degree          hubs first, so the most visited vertices share lines
+ *   Cuthill-McKee   breadth-first, so neighbors get nearby numbers
+ *   community       tightly connected groups get consecutive numbers
+ *
+ * Every order is a permutation with permutation[old] = new. csrPermute and
+ * graphPermute apply one; permutationInverse maps new numbers back.
+ */
+
+#include "graphReorder.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* Label propagation stops after this many passes even if labels change. */
+#define COMMUNITY_ROUNDS 10
+
+static int compareIndices(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int compareKeys(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Returns the number of neighbors of a vertex.
+ * @param graph
+ * @param vertex
+ * @return Degree of the vertex.
+ */
+static inline int degree(CsrGraph* graph, int vertex)
+{
+    return (int)(graph->offsets[vertex + 1] - graph->offsets[vertex]);
+}
+
+/**
+ * Returns the vertices sorted by degree with a counting sort, ties in
+ * vertex order.
+ * @param graph
+ * @param descending 1 for largest degree first, 0 for smallest first.
+ * @return Array of numVertices vertex indices.
+ */
+static int* sortByDegree(CsrGraph* graph, int descending)
+{
+    int numVertices = graph->numVertices;
+    int maxDegree = 0;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        if (degree(graph, i) > maxDegree)
+        {
+            maxDegree = degree(graph, i);
+        }
+    }
+    int* starts = calloc((size_t)maxDegree + 2, sizeof(int));
+    int* sorted = malloc(sizeof(int) * ((size_t)numVertices + 1));
+    assert(starts != 0 && sorted != 0);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        int key = descending ? maxDegree - degree(graph, i) : degree(graph, i);
+        ++starts[key + 1];
+    }
+    for (int d = 0; d <= maxDegree; ++d)
+    {
+        starts[d + 1] += starts[d];
+    }
+    for (int i = 0; i < numVertices; ++i)
+    {
+        int key = descending ? maxDegree - degree(graph, i) : degree(graph, i);
+        sorted[starts[key]++] = i;
+    }
+    free(starts);
+    return sorted;
+}
+
+/**
+ * Returns the permutation that numbers vertices in the given sequence.
+ * @param sequence Every vertex once, in its new order. Freed.
+ * @param size
+ * @return The permutation.
+ */
+static int* sequenceToPermutation(int* sequence, int size)
+{
+    int* permutation = permutationInverse(sequence, size);
+    free(sequence);
+    return permutation;
+}
+
+/**
+ * Returns the inverse of a permutation.
+ * @param permutation permutation[i] is where i goes.
+ * @param size
+ * @return inverse, with inverse[permutation[i]] = i.
+ */
+int* permutationInverse(const int* permutation, int size)
+{
+    int* inverse = malloc(sizeof(int) * ((size_t)size + 1));
+    assert(inverse != 0);
+    for (int i = 0; i < size; ++i)
+    {
+        assert(permutation[i] >= 0 && permutation[i] < size);
+        inverse[permutation[i]] = i;
+    }
+    return inverse;
+}
+
+/**
+ * Orders vertices by decreasing degree. Power-law graphs have a few hubs
+ * that appear in most adjacency lists; numbering them first packs the
+ * vertices nearly every traversal touches into a few cache lines.
+ * @param graph
+ * @return The permutation, permutation[old] = new.
+ */
+int* csrDegreeOrder(CsrGraph* graph)
+{
+    return sequenceToPermutation(sortByDegree(graph, 1), graph->numVertices);
+}
+
+/**
+ * Orders vertices by reverse Cuthill-McKee. Each component is searched
+ * breadth-first from a vertex of smallest degree, adding the unvisited
+ * neighbors of each vertex in order of increasing degree, and the resulting
+ * sequence is reversed. Adjacent vertices end up with close numbers, which
+ * keeps each frontier and its neighbor lists in a narrow band of memory.
+ * @param graph
+ * @return The permutation, permutation[old] = new.
+ */
+int* csrCuthillMcKeeOrder(CsrGraph* graph)
+{
+    int numVertices = graph->numVertices;
+    int* byDegree = sortByDegree(graph, 0);
+    int maxDegree = numVertices > 0 ? degree(graph, byDegree[numVertices - 1])
+                                    : 0;
+    int* sequence = malloc(sizeof(int) * ((size_t)numVertices + 1));
+    char* visited = calloc((size_t)numVertices + 1, 1);
+    uint64_t* keys = malloc(sizeof(uint64_t) * ((size_t)maxDegree + 1));
+    assert(sequence != 0 && visited != 0 && keys != 0);
+
+    int tail = 0;
+    for (int k = 0; k < numVertices; ++k)
+    {
+        int start = byDegree[k];
+        if (visited[start])
+        {
+            continue;
+        }
+        visited[start] = 1;
+        int head = tail;
+        sequence[tail++] = start;
+        while (head < tail)
+        {
+            int vertex = sequence[head++];
+            int count = 0;
+            for (uint64_t j = graph->offsets[vertex];
+                 j < graph->offsets[vertex + 1]; ++j)
+            {
+                uint32_t neighbor = graph->neighbors[j];
+                if (!visited[neighbor])
+                {
+                    visited[neighbor] = 1;
+                    keys[count++] = (uint64_t)degree(graph, (int)neighbor)
+                                    << 32 | neighbor;
+                }
+            }
+            qsort(keys, (size_t)count, sizeof(uint64_t), compareKeys);
+            for (int j = 0; j < count; ++j)
+            {
+                sequence[tail++] = (int)(uint32_t)keys[j];
+            }
+        }
+    }
+
+    for (int i = 0; i < numVertices / 2; ++i)
+    {
+        int temp = sequence[i];
+        sequence[i] = sequence[numVertices - 1 - i];
+        sequence[numVertices - 1 - i] = temp;
+    }
+    free(byDegree);
+    free(visited);
+    free(keys);
+    return sequenceToPermutation(sequence, numVertices);
+}
+
+/**
+ * Orders vertices by community, in the spirit of Rabbit Order: vertices
+ * whose neighbors mostly lie in one group are numbered with that group.
+ * Communities are found by label propagation: every vertex starts with its
+ * own label and repeatedly takes the label most common among its neighbors,
+ * keeping its own on a tie, until no label changes or COMMUNITY_ROUNDS
+ * passes are done. Each community then gets a consecutive block of numbers,
+ * vertices keeping their relative order inside it.
+ * @param graph
+ * @return The permutation, permutation[old] = new.
+ */
+int* csrCommunityOrder(CsrGraph* graph)
+{
+    int numVertices = graph->numVertices;
+    int* labels = malloc(sizeof(int) * ((size_t)numVertices + 1));
+    int* counts = calloc((size_t)numVertices + 1, sizeof(int));
+    int* touched = malloc(sizeof(int) * ((size_t)numVertices + 1));
+    assert(labels != 0 && counts != 0 && touched != 0);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        labels[i] = i;
+    }
+
+    for (int round = 0; round < COMMUNITY_ROUNDS; ++round)
+    {
+        int changed = 0;
+        for (int vertex = 0; vertex < numVertices; ++vertex)
+        {
+            int numTouched = 0;
+            for (uint64_t j = graph->offsets[vertex];
+                 j < graph->offsets[vertex + 1]; ++j)
+            {
+                int label = labels[graph->neighbors[j]];
+                if (counts[label]++ == 0)
+                {
+                    touched[numTouched++] = label;
+                }
+            }
+            int best = labels[vertex];
+            int bestCount = counts[best];
+            for (int k = 0; k < numTouched; ++k)
+            {
+                int label = touched[k];
+                if (counts[label] > bestCount)
+                {
+                    best = label;
+                    bestCount = counts[label];
+                }
+                counts[label] = 0;
+            }
+            if (best != labels[vertex])
+            {
+                labels[vertex] = best;
+                ++changed;
+            }
+        }
+        if (changed == 0)
+        {
+            break;
+        }
+    }
+
+    /* Counting sort by label; labels are vertex indices. */
+    memset(counts, 0, sizeof(int) * ((size_t)numVertices + 1));
+    for (int i = 0; i < numVertices; ++i)
+    {
+        ++counts[labels[i] + 1];
+    }
+    for (int i = 0; i < numVertices - 1; ++i)
+    {
+        counts[i + 1] += counts[i];
+    }
+    int* permutation = touched;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        permutation[i] = counts[labels[i]]++;
+    }
+    free(labels);
+    free(counts);
+    return permutation;
+}
+
+/**
+ * Builds a renumbered copy of a CSR graph, with vertex i of the graph
+ * becoming vertex permutation[i] and every list sorted. The graph is not
+ * modified.
+ * @param graph
+ * @param permutation permutation[old] = new, a permutation of the vertices.
+ * @return The renumbered CSR graph.
+ */
+CsrGraph* csrPermute(CsrGraph* graph, const int* permutation)
+{
+    int numVertices = graph->numVertices;
+    int* inverse = permutationInverse(permutation, numVertices);
+    CsrGraph* csr = malloc(sizeof(CsrGraph));
+    assert(csr != 0);
+    csr->numVertices = numVertices;
+    csr->numEdges = graph->numEdges;
+    csr->image = NULL;
+    csr->imageSize = 0;
+    csr->isMapped = 0;
+    csr->offsets = malloc(sizeof(uint64_t) * ((size_t)numVertices + 1));
+    csr->neighbors = malloc(sizeof(uint32_t) *
+                            ((size_t)graph->offsets[numVertices] + 1));
+    assert(csr->offsets != 0 && csr->neighbors != 0);
+
+    uint64_t total = 0;
+    for (int i = 0; i < numVertices; ++i)
+    {
+        int old = inverse[i];
+        csr->offsets[i] = total;
+        uint32_t* out = csr->neighbors + total;
+        int count = degree(graph, old);
+        const uint32_t* in = graph->neighbors + graph->offsets[old];
+        for (int j = 0; j < count; ++j)
+        {
+            out[j] = (uint32_t)permutation[in[j]];
+        }
+        qsort(out, (size_t)count, sizeof(uint32_t), compareIndices);
+        total += (uint64_t)count;
+    }
+    csr->offsets[numVertices] = total;
+    free(inverse);
+    return csr;
+}
+
+/**
+ * Renumbers a graph in place: the vertex at index i of vertexSet moves to
+ * index permutation[i], and every neighbor pointer follows it. Labels are
+ * not changed, so a vertex's label still names it as before. Any
+ * ComponentIndex or traversal results computed for the old numbering are
+ * no longer valid.
+ * @param graph
+ * @param permutation permutation[old] = new, a permutation of the vertices.
+ */
+void graphPermute(Graph* graph, const int* permutation)
+{
+    int numVertices = graph->numVertices;
+    Vertex* vertexSet = malloc(sizeof(Vertex) * ((size_t)numVertices + 1));
+    assert(vertexSet != 0);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        assert(permutation[i] >= 0 && permutation[i] < numVertices);
+        vertexSet[permutation[i]] = graph->vertexSet[i];
+    }
+    for (int i = 0; i < numVertices; ++i)
+    {
+        Vertex* vertex = &vertexSet[i];
+        for (int j = 0; j < vertex->numNeighbors; ++j)
+        {
+            int old = (int)(vertex->neighbors[j] - graph->vertexSet);
+            vertex->neighbors[j] = &vertexSet[permutation[old]];
+        }
+    }
+    free(graph->vertexSet);
+    graph->vertexSet = vertexSet;
+}
@@ -0,0 +1,21 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Vertex reordering for cache locality.
+ */
+
+#ifndef GRAPH_REORDER_H
+#define GRAPH_REORDER_H
+
+#include "graph.h"
+#include "csrGraph.h"
+
+int* csrDegreeOrder(CsrGraph* graph);
+int* csrCuthillMcKeeOrder(CsrGraph* graph);
+int* csrCommunityOrder(CsrGraph* graph);
+int* permutationInverse(const int* permutation, int size);
+
+CsrGraph* csrPermute(CsrGraph* graph, const int* permutation);
+void graphPermute(Graph* graph, const int* permutation);
+
+#endif
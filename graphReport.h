@@ -0,0 +1,15 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Writing a Graph through a ReportWriter.
+ */
+
+#ifndef GRAPH_REPORT_H
+#define GRAPH_REPORT_H
+
+#include "graph.h"
+#include "reportWriter.h"
+
+void graphReport(Graph* graph, ReportWriter* writer);
+
+#endif
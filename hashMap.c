@@ -7,10 +7,14 @@
  */
 
 #include "hashMap.h"
+#include "hashMapMerge.h"
+#include "hashMapReport.h"
+#include "profiler.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
 
 int hashFunction1(const char* key)
 {
@@ -157,7 +161,7 @@ int* hashMapGet(HashMap* map, const char* key)
     /* Loop through bucket, if match, return the value. */
     while(temp!= NULL)
     {
-        if(*(temp->key) == *(key))
+        if(strcmp(temp->key, key) == 0)
         {
             value = &temp->value;
         }
@@ -166,6 +170,23 @@ int* hashMapGet(HashMap* map, const char* key)
     return value;
 }
 
+/**
+ * Returns the bucket index for the given key in a table with the given number
+ * of buckets.
+ * @param key
+ * @param capacity
+ * @return Bucket index in [0, capacity).
+ */
+static int bucketIndex(const char* key, int capacity)
+{
+    int index = HASH_FUNCTION(key) % capacity;
+    if (index < 0)
+    {
+        index += capacity;
+    }
+    return index;
+}
+
 /**
  * Resizes the hash table to have a number of buckets equal to the given
  * capacity. After allocating the new table, all of the links need to be
@@ -182,30 +203,44 @@ void resizeTable(HashMap* map, int capacity)
     // FIXME: implement
     assert(map != 0);
     assert(capacity > 0);
-    /* Create new map with new capacity */
-    HashMap* newMap = hashMapNew(capacity);
-  
-    /* Copy links from old map to new. */
+    PROFILE_BEGIN(PHASE_RESIZE);
+    PROFILE_COUNT(PHASE_RESIZE, 0, map->size);
+    /* Relink every link into the new table instead of copying it with
+     * hashMapPut. Links are appended to their new buckets, so each bucket
+     * keeps the order a rehash with hashMapPut would give. */
+    HashLink** table = malloc(sizeof(HashLink*) * capacity);
+    HashLink** tails = malloc(sizeof(HashLink*) * capacity);
+    assert(table != 0 && tails != 0);
+    for(int i = 0; i < capacity; i++)
+    {
+        table[i] = NULL;
+    }
     for(int i = 0; i < map->capacity; i++)
     {
-        HashLink* temp;
-
-        if(map->table[i]!= NULL)
+        HashLink* link = map->table[i];
+        while(link != NULL)
         {
-            temp = map->table[i];
-            while(temp != NULL)
+            HashLink* next = link->next;
+            int index = bucketIndex(link->key, capacity);
+            link->next = NULL;
+            if(table[index] == NULL)
+            {
+                table[index] = link;
+            }
+            else
             {
-                hashMapPut(newMap, temp->key, temp->value);
-                temp = temp->next;
+                tails[index]->next = link;
             }
+            tails[index] = link;
+            link = next;
         }
     }
-    /* Clean up and free old map, point old map to newMap and free newMap pointer. */
-    hashMapCleanUp(map);
-    map->table = newMap->table;
+    /* Free the old table and point the map to the new one. */
+    free(map->table);
+    free(tails);
+    map->table = table;
     map->capacity = capacity;
-    map->size = newMap->size;
-    free(newMap);
+    PROFILE_END(PHASE_RESIZE);
 }
 
 /**
@@ -252,7 +287,7 @@ void hashMapPut(HashMap* map, const char* key, int value)
         int match = 0;
         while((temp != NULL) && (match == 0))
         {
-            if(*(temp->key) == *(key)) /* If key found, update value. */
+            if(strcmp(temp->key, key) == 0) /* If key found, update value. */
             {
                 temp->value = value;
                 match = 1;
@@ -287,19 +322,25 @@ void hashMapRemove(HashMap* map, const char* key)
     // FIXME: implement
     /* First get index. */
     int index = HASH_FUNCTION(key)%map->capacity;
+    if(index < 0)
+    {
+        index += map->capacity;
+    }
     
+    HashLink** prev = &map->table[index];
     HashLink* temp = map->table[index];
     
-    /* Then traverse until link is found, then delete link. */
+    /* Then traverse until link is found, then unlink and delete it. */
     while(temp!= NULL)
     {
-        if(*(temp->key) == *(key))
+        if(strcmp(temp->key, key) == 0)
         {
-            map->table[index] = map->table[index]->next;
+            *prev = temp->next;
             hashLinkDelete(temp);
             map->size--;
             break;
         }
+        prev = &temp->next;
         temp = temp->next;
     }
     
@@ -320,12 +361,16 @@ int hashMapContainsKey(HashMap* map, const char* key)
     // FIXME: implement
     /* First get index */
     int index = HASH_FUNCTION(key)%map->capacity;
+    if(index < 0)
+    {
+        index += map->capacity;
+    }
     HashLink* temp = map->table[index];
    
     /* Traverse bucket to see if match is found. */
     while(temp!= NULL)
     {
-        if(*(temp->key) == *(key)) 
+        if(strcmp(temp->key, key) == 0) 
         {
             return 1;
         }
@@ -398,24 +443,297 @@ float hashMapTableLoad(HashMap* map)
 }
 
 /**
- * Prints all the links in each of the buckets in the table.
+ * Writes all the links in the table in the writer's format. Text lists each
+ * bucket as hashMapPrint always has, CSV writes a key,value row per link, and
+ * binary writes the link count followed by each key and value.
  * @param map
+ * @param writer
  */
-void hashMapPrint(HashMap* map)
+void hashMapReport(HashMap* map, ReportWriter* writer)
 {
+    ReportFormat format = reportFormat(writer);
+    if (format == REPORT_CSV)
+    {
+        reportWriteString(writer, "key,value\n");
+    }
+    else if (format == REPORT_BINARY)
+    {
+        reportWriteBinaryInt(writer, map->size);
+    }
+    
     for (int i = 0; i < map->capacity; i++)
     {
         HashLink* link = map->table[i];
         
-        if (link != NULL)
+        if (link != NULL && format == REPORT_TEXT)
+        {
+            reportWriteString(writer, "\nBucket ");
+            reportWriteInt(writer, i);
+            reportWriteString(writer, " ->");
+        }
+        while (link != NULL)
+        {
+            if (format == REPORT_TEXT)
+            {
+                reportWriteString(writer, " (");
+                reportWriteString(writer, link->key);
+                reportWriteString(writer, ", ");
+                reportWriteInt(writer, link->value);
+                reportWriteString(writer, ") ->");
+            }
+            else if (format == REPORT_CSV)
+            {
+                reportWriteCsvField(writer, link->key);
+                reportWriteChar(writer, ',');
+                reportWriteInt(writer, link->value);
+                reportWriteChar(writer, '\n');
+            }
+            else
+            {
+                reportWriteBinaryString(writer, link->key);
+                reportWriteBinaryInt(writer, link->value);
+            }
+            link = link->next;
+        }
+    }
+    if (format == REPORT_TEXT)
+    {
+        reportWriteChar(writer, '\n');
+    }
+}
+
+/**
+ * Prints all the links in each of the buckets in the table.
+ * @param map
+ */
+void hashMapPrint(HashMap* map)
+{
+    ReportWriter* writer = reportWriterNew(stdout, REPORT_TEXT);
+    hashMapReport(map, writer);
+    reportWriterDelete(writer);
+}
+
+/**
+ * Moves every link in the source buckets [begin, end) into the same buckets of
+ * the destination table. Both tables must have the same capacity, so a link
+ * never changes bucket and disjoint ranges never touch the same bucket. Links
+ * whose key is already in the destination are combined and freed, the others
+ * are unlinked from the source and pushed on the destination bucket as is.
+ * @param dst Destination bucket table.
+ * @param src Source bucket table.
+ * @param begin First bucket to merge.
+ * @param end One past the last bucket to merge.
+ * @param combine Combines the destination and source values for shared keys.
+ * @return Number of links added to the destination.
+ */
+static int mergeBuckets(HashLink** dst, HashLink** src, int begin, int end,
+                        HashMapCombineFunction combine)
+{
+    int added = 0;
+    for (int i = begin; i < end; i++)
+    {
+        HashLink* link = src[i];
+        src[i] = NULL;
+        while (link != NULL)
         {
-            printf("\nBucket %i ->", i);
-            while (link != NULL)
+            HashLink* next = link->next;
+            HashLink* match = dst[i];
+            while (match != NULL && strcmp(match->key, link->key) != 0)
+            {
+                match = match->next;
+            }
+            if (match != NULL)
             {
-                printf(" (%s, %d) ->", link->key, link->value);
-                link = link->next;
+                match->value = combine(match->value, link->value);
+                hashLinkDelete(link);
             }
+            else
+            {
+                link->next = dst[i];
+                dst[i] = link;
+                added++;
+            }
+            link = next;
         }
     }
-    printf("\n");
-}
\ No newline at end of file
+    return added;
+}
+
+/**
+ * Returns the smallest capacity, doubling from the map's current one, that
+ * keeps the given number of links at or under MAX_TABLE_LOAD.
+ * @param map
+ * @param size Number of links the table must hold.
+ * @return Capacity to resize to.
+ */
+static int reserveCapacity(HashMap* map, int size)
+{
+    int capacity = map->capacity;
+    while ((float)size / (float)capacity > MAX_TABLE_LOAD)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * Moves every link from the source map into the destination map. Keys found
+ * in both maps have their values merged with combine, e.g. summing word
+ * counts. The destination is resized at most once, up front, for the combined
+ * size, and links are relinked rather than copied, so no key is reallocated.
+ * The source map is left empty but still valid.
+ * @param dst
+ * @param src
+ * @param combine Returns the merged value given the dst and src values.
+ */
+void hashMapMerge(HashMap* dst, HashMap* src, HashMapCombineFunction combine)
+{
+    assert(dst != 0);
+    assert(src != 0);
+    assert(combine != 0);
+    
+    int capacity = reserveCapacity(dst, dst->size + src->size);
+    if (capacity != dst->capacity)
+    {
+        resizeTable(dst, capacity);
+    }
+    
+    if (dst->capacity == src->capacity)
+    {
+        dst->size += mergeBuckets(dst->table, src->table, 0, src->capacity,
+                                  combine);
+        src->size = 0;
+        return;
+    }
+    
+    for (int i = 0; i < src->capacity; i++)
+    {
+        HashLink* link = src->table[i];
+        src->table[i] = NULL;
+        while (link != NULL)
+        {
+            HashLink* next = link->next;
+            int index = bucketIndex(link->key, dst->capacity);
+            HashLink* match = dst->table[index];
+            while (match != NULL && strcmp(match->key, link->key) != 0)
+            {
+                match = match->next;
+            }
+            if (match != NULL)
+            {
+                match->value = combine(match->value, link->value);
+                hashLinkDelete(link);
+            }
+            else
+            {
+                link->next = dst->table[index];
+                dst->table[index] = link;
+                dst->size++;
+            }
+            link = next;
+        }
+    }
+    src->size = 0;
+}
+
+typedef struct MergeTask MergeTask;
+
+struct MergeTask
+{
+    HashLink** dst;
+    HashLink** src;
+    int begin;
+    int end;
+    HashMapCombineFunction combine;
+    int added;
+};
+
+static void* mergeTaskRun(void* arg)
+{
+    MergeTask* task = arg;
+    task->added = mergeBuckets(task->dst, task->src, task->begin, task->end,
+                               task->combine);
+    return NULL;
+}
+
+/**
+ * Same as hashMapMerge, but splits the bucket range across numThreads
+ * threads. With equal capacities a key hashes to the same bucket index in
+ * both maps, so each thread owns a disjoint slice of both tables and no
+ * locking is needed. If the capacities differ, or the combined size would
+ * overload the table, both maps are first resized to a common capacity. A
+ * range whose thread cannot be started is merged on the calling thread.
+ * @param dst
+ * @param src
+ * @param combine Returns the merged value given the dst and src values.
+ * @param numThreads Number of worker threads, at least 1.
+ */
+void hashMapMergeParallel(HashMap* dst, HashMap* src,
+                          HashMapCombineFunction combine, int numThreads)
+{
+    assert(dst != 0);
+    assert(src != 0);
+    assert(combine != 0);
+    assert(numThreads > 0);
+    
+    int capacity = reserveCapacity(dst, dst->size + src->size);
+    if (capacity < src->capacity)
+    {
+        capacity = src->capacity;
+    }
+    if (capacity != dst->capacity)
+    {
+        resizeTable(dst, capacity);
+    }
+    if (capacity != src->capacity)
+    {
+        resizeTable(src, capacity);
+    }
+    if (numThreads > capacity)
+    {
+        numThreads = capacity;
+    }
+    
+    MergeTask* tasks = malloc(sizeof(MergeTask) * numThreads);
+    pthread_t* threads = malloc(sizeof(pthread_t) * numThreads);
+    assert(tasks != 0 && threads != 0);
+    for (int t = 0; t < numThreads; t++)
+    {
+        tasks[t].dst = dst->table;
+        tasks[t].src = src->table;
+        tasks[t].begin = (int)((long)capacity * t / numThreads);
+        tasks[t].end = (int)((long)capacity * (t + 1) / numThreads);
+        tasks[t].combine = combine;
+        tasks[t].added = 0;
+    }
+    
+    /* The calling thread takes the first range, and any range whose thread
+     * fails to start. */
+    int* started = calloc(numThreads, sizeof(int));
+    assert(started != 0);
+    for (int t = 1; t < numThreads; t++)
+    {
+        started[t] = pthread_create(&threads[t], NULL, mergeTaskRun,
+                                    &tasks[t]) == 0;
+    }
+    mergeTaskRun(&tasks[0]);
+    for (int t = 1; t < numThreads; t++)
+    {
+        if (started[t])
+        {
+            pthread_join(threads[t], NULL);
+        }
+        else
+        {
+            mergeTaskRun(&tasks[t]);
+        }
+    }
+    for (int t = 0; t < numThreads; t++)
+    {
+        dst->size += tasks[t].added;
+    }
+    free(started);
+    src->size = 0;
+    free(threads);
+    free(tasks);
+}
@@ -0,0 +1,22 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Merging one HashMap into another by moving its links.
+ */
+
+#ifndef HASH_MAP_MERGE_H
+#define HASH_MAP_MERGE_H
+
+#include "hashMap.h"
+
+/**
+ * Combines the values of a key found in both maps during hashMapMerge.
+ * Receives the destination value first and the source value second.
+ */
+typedef int (*HashMapCombineFunction)(int, int);
+
+void hashMapMerge(HashMap* dst, HashMap* src, HashMapCombineFunction combine);
+void hashMapMergeParallel(HashMap* dst, HashMap* src,
+                          HashMapCombineFunction combine, int numThreads);
+
+#endif
@@ -0,0 +1,15 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Writing a HashMap through a ReportWriter.
+ */
+
+#ifndef HASH_MAP_REPORT_H
+#define HASH_MAP_REPORT_H
+
+#include "hashMap.h"
+#include "reportWriter.h"
+
+void hashMapReport(HashMap* map, ReportWriter* writer);
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Main file for the positional inverted index program.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "invertedIndex.h"
+#include "tokenizer.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Indexes the files given on the command line and prints index statistics.
+ * Options: -f case folds words, -t n uses n threads (default: one per core),
+ * and -q word... lists the files containing every given word, with the
+ * positions of the first word in each. Query words are tokenized and case
+ * folded the same way as the indexed text.
+ * @param argc
+ * @param argv
+ * @return
+ */
+int main(int argc, const char** argv)
+{
+    const char** fileNames = malloc(sizeof(char*) * argc);
+    const char** queryWords = malloc(sizeof(char*) * argc);
+    int numFiles = 0;
+    int numQueryWords = 0;
+    int foldCase = 0;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int inQuery = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (inQuery)
+        {
+            queryWords[numQueryWords++] = argv[i];
+        }
+        else if (strcmp(argv[i], "-f") == 0)
+        {
+            foldCase = 1;
+        }
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            numThreads = (int) strtol(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "-q") == 0)
+        {
+            inQuery = 1;
+        }
+        else
+        {
+            fileNames[numFiles++] = argv[i];
+        }
+    }
+    if (numFiles == 0)
+    {
+        printf("Usage: %s [-f] [-t threads] file... [-q word...]\n", argv[0]);
+        return 1;
+    }
+    if (numThreads < 1)
+    {
+        numThreads = 1;
+    }
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    InvertedIndex* index = invertedIndexBuild(fileNames, numFiles, numThreads,
+                                              foldCase);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    
+    long numPostings = invertedIndexNumPostings(index);
+    long postingBytes = invertedIndexPostingBytes(index);
+    printf("Indexed %d files with %d threads in %f seconds\n", numFiles,
+           numThreads, (end.tv_sec - start.tv_sec)
+           + (end.tv_nsec - start.tv_nsec) / 1e9);
+    printf("Distinct words: %d\n", invertedIndexNumTerms(index));
+    printf("Positions: %ld\n", numPostings);
+    printf("Posting bytes: %ld (%.2f per position)\n", postingBytes,
+           numPostings ? (double)postingBytes / numPostings : 0.0);
+    
+    if (numQueryWords > 0)
+    {
+        /* A query word without a word in it keeps its text and finds
+         * nothing. */
+        const char** terms = malloc(sizeof(char*) * numQueryWords);
+        char** folded = malloc(sizeof(char*) * numQueryWords);
+        for (int i = 0; i < numQueryWords; i++)
+        {
+            folded[i] = tokenizerWord(queryWords[i], foldCase);
+            terms[i] = folded[i] != NULL ? folded[i] : queryWords[i];
+        }
+        int* documents;
+        int numDocuments = invertedIndexQuery(index, terms, numQueryWords,
+                                              &documents);
+        Posting* postings;
+        int numPostingsOfFirst = invertedIndexPostings(index, terms[0],
+                                                       &postings);
+        printf("\nFiles containing all %d words: %d\n", numQueryWords,
+               numDocuments);
+        int p = 0;
+        for (int i = 0; i < numDocuments; i++)
+        {
+            printf("%s :", fileNames[documents[i]]);
+            while (p < numPostingsOfFirst
+                   && postings[p].document < documents[i])
+            {
+                p++;
+            }
+            for (; p < numPostingsOfFirst
+                 && postings[p].document == documents[i]; p++)
+            {
+                printf(" %d", postings[p].offset);
+            }
+            printf("\n");
+        }
+        free(postings);
+        free(documents);
+        for (int i = 0; i < numQueryWords; i++)
+        {
+            free(folded[i]);
+        }
+        free(folded);
+        free(terms);
+    }
+    
+    invertedIndexDelete(index);
+    free(queryWords);
+    free(fileNames);
+    return 0;
+}
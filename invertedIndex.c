@@ -0,0 +1,548 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * InvertedIndex implementation file.
+ *
+ * The dictionary is a HashMap from word to term id, and each term id owns a
+ * posting list of every (document, offset) at which the word occurs, sorted
+ * by document and then offset. A posting list is a byte stream of varint
+ * pairs (documentDelta, offsetDelta). documentDelta is the document minus the
+ * previous posting's document, counting from -1 so the first delta is never
+ * 0; a documentDelta of 0 means the same document as before, in which case
+ * offsetDelta is relative to the previous offset, otherwise it is the offset
+ * itself.
+ *
+ * Building splits the files into contiguous ranges, one per thread. Every
+ * thread tokenizes its files into a private dictionary and private posting
+ * lists, and the partial lists are then appended in range order, which keeps
+ * each merged list sorted. Only the first document delta of each appended
+ * part has to be re-encoded.
+ */
+
+#include "invertedIndex.h"
+#include "hashMap.h"
+#include "tokenizer.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+
+typedef struct PostingList PostingList;
+typedef struct IndexPart IndexPart;
+
+struct PostingList
+{
+    unsigned char* bytes;
+    int length;
+    int capacity;
+    int numPostings;
+    int numDocuments;
+    int lastDocument;
+    int lastOffset;
+};
+
+struct IndexPart
+{
+    const char** fileNames;
+    int firstDocument;
+    int numDocuments;
+    int foldCase;
+    HashMap* terms;         /* Word to local term id */
+    PostingList* lists;
+    int numLists;
+    int listCapacity;
+};
+
+struct InvertedIndex
+{
+    HashMap* terms;         /* Word to term id */
+    PostingList* lists;
+    int numTerms;
+    int numDocuments;
+};
+
+/**
+ * Appends an unsigned integer in LEB128 varint form.
+ * @param list
+ * @param value
+ */
+static void putVarint(PostingList* list, uint32_t value)
+{
+    if (list->length + 5 > list->capacity)
+    {
+        list->capacity = list->capacity ? list->capacity * 2 : 16;
+        list->bytes = realloc(list->bytes, list->capacity);
+        assert(list->bytes != 0);
+    }
+    while (value >= 0x80)
+    {
+        list->bytes[list->length++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    list->bytes[list->length++] = (unsigned char)value;
+}
+
+/**
+ * Reads a varint at the given position and advances it.
+ * @param bytes
+ * @param pos
+ * @return The decoded value.
+ */
+static uint32_t getVarint(const unsigned char* bytes, int* pos)
+{
+    uint32_t value = 0;
+    int shift = 0;
+    unsigned char b;
+    do
+    {
+        b = bytes[(*pos)++];
+        value |= (uint32_t)(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+    return value;
+}
+
+static void listInit(PostingList* list)
+{
+    list->bytes = NULL;
+    list->length = 0;
+    list->capacity = 0;
+    list->numPostings = 0;
+    list->numDocuments = 0;
+    list->lastDocument = -1;
+    list->lastOffset = 0;
+}
+
+/**
+ * Appends a posting. Postings must arrive in (document, offset) order.
+ * @param list
+ * @param document
+ * @param offset
+ */
+static void listAdd(PostingList* list, int document, int offset)
+{
+    if (document == list->lastDocument)
+    {
+        putVarint(list, 0);
+        putVarint(list, (uint32_t)(offset - list->lastOffset));
+    }
+    else
+    {
+        putVarint(list, (uint32_t)(document - list->lastDocument));
+        putVarint(list, (uint32_t)offset);
+        list->numDocuments++;
+    }
+    list->lastDocument = document;
+    list->lastOffset = offset;
+    list->numPostings++;
+}
+
+/**
+ * Appends a partial list whose documents all follow the list's last one.
+ * @param list
+ * @param part
+ */
+static void listAppend(PostingList* list, PostingList* part)
+{
+    int pos = 0;
+    uint32_t firstDocument = getVarint(part->bytes, &pos) - 1;
+    putVarint(list, firstDocument - (uint32_t)list->lastDocument);
+    
+    int rest = part->length - pos;
+    if (list->length + rest > list->capacity)
+    {
+        while (list->length + rest > list->capacity)
+        {
+            list->capacity *= 2;
+        }
+        list->bytes = realloc(list->bytes, list->capacity);
+        assert(list->bytes != 0);
+    }
+    memcpy(list->bytes + list->length, part->bytes + pos, rest);
+    list->length += rest;
+    list->numPostings += part->numPostings;
+    list->numDocuments += part->numDocuments;
+    list->lastDocument = part->lastDocument;
+    list->lastOffset = part->lastOffset;
+}
+
+/**
+ * Returns the id of the word in the given dictionary, adding it with a new
+ * empty posting list if needed.
+ */
+static int termId(HashMap* terms, PostingList** lists, int* numLists,
+                  int* listCapacity, const char* word)
+{
+    int* id = hashMapGet(terms, word);
+    if (id != NULL)
+    {
+        return *id;
+    }
+    if (*numLists == *listCapacity)
+    {
+        *listCapacity *= 2;
+        *lists = realloc(*lists, sizeof(PostingList) * *listCapacity);
+        assert(*lists != 0);
+    }
+    listInit(&(*lists)[*numLists]);
+    hashMapPut(terms, word, *numLists);
+    return (*numLists)++;
+}
+
+/**
+ * Thread body: indexes the part's range of files.
+ * @param arg The IndexPart.
+ * @return NULL
+ */
+static void* indexPart(void* arg)
+{
+    IndexPart* part = arg;
+    for (int d = 0; d < part->numDocuments; d++)
+    {
+        int document = part->firstDocument + d;
+        FILE* file = fopen(part->fileNames[document], "r");
+        if (file == NULL)
+        {
+            fprintf(stderr, "File does not exist: %s\n",
+                    part->fileNames[document]);
+            continue;
+        }
+        Tokenizer* tokenizer = tokenizerNew(file, part->foldCase);
+        char* word;
+        int offset = 0;
+        while ((word = tokenizerNext(tokenizer)) != NULL)
+        {
+            int id = termId(part->terms, &part->lists, &part->numLists,
+                            &part->listCapacity, word);
+            listAdd(&part->lists[id], document, offset++);
+            free(word);
+        }
+        tokenizerDelete(tokenizer);
+        fclose(file);
+    }
+    return NULL;
+}
+
+/**
+ * Builds the index of the given files. File i is document i.
+ * @param fileNames
+ * @param numFiles
+ * @param numThreads Number of threads tokenizing files in parallel.
+ * @param foldCase 1 to case fold words.
+ * @return The index.
+ */
+InvertedIndex* invertedIndexBuild(const char** fileNames, int numFiles,
+                                  int numThreads, int foldCase)
+{
+    assert(numFiles >= 0);
+    assert(numThreads > 0);
+    if (numThreads > numFiles)
+    {
+        numThreads = numFiles > 0 ? numFiles : 1;
+    }
+    
+    IndexPart* parts = malloc(sizeof(IndexPart) * numThreads);
+    pthread_t* threads = malloc(sizeof(pthread_t) * numThreads);
+    int* started = malloc(sizeof(int) * numThreads);
+    assert(parts != 0 && threads != 0 && started != 0);
+    for (int t = 0; t < numThreads; t++)
+    {
+        IndexPart* part = &parts[t];
+        part->fileNames = fileNames;
+        part->firstDocument = (int)((long)numFiles * t / numThreads);
+        part->numDocuments = (int)((long)numFiles * (t + 1) / numThreads)
+            - part->firstDocument;
+        part->foldCase = foldCase;
+        part->terms = hashMapNew(1024);
+        part->listCapacity = 1024;
+        part->numLists = 0;
+        part->lists = malloc(sizeof(PostingList) * part->listCapacity);
+        assert(part->lists != 0);
+        /* A part whose thread cannot be started is indexed here. */
+        started[t] = pthread_create(&threads[t], NULL, indexPart,
+                                    part) == 0;
+        if (!started[t])
+        {
+            indexPart(part);
+        }
+    }
+    
+    InvertedIndex* index = malloc(sizeof(InvertedIndex));
+    assert(index != 0);
+    index->terms = hashMapNew(1024);
+    index->numTerms = 0;
+    index->numDocuments = numFiles;
+    int listCapacity = 1024;
+    index->lists = malloc(sizeof(PostingList) * listCapacity);
+    assert(index->lists != 0);
+    
+    /* Merge the parts in document order. */
+    for (int t = 0; t < numThreads; t++)
+    {
+        if (started[t])
+        {
+            pthread_join(threads[t], NULL);
+        }
+        IndexPart* part = &parts[t];
+        HashMap* terms = part->terms;
+        for (int i = 0; i < terms->capacity; i++)
+        {
+            for (HashLink* link = terms->table[i]; link != NULL;
+                 link = link->next)
+            {
+                int id = termId(index->terms, &index->lists,
+                                &index->numTerms, &listCapacity, link->key);
+                PostingList* local = &part->lists[link->value];
+                if (index->lists[id].numPostings == 0)
+                {
+                    index->lists[id] = *local;  /* Take the bytes over */
+                }
+                else
+                {
+                    listAppend(&index->lists[id], local);
+                    free(local->bytes);
+                }
+            }
+        }
+        hashMapDelete(terms);
+        free(part->lists);
+    }
+    
+    free(started);
+    free(threads);
+    free(parts);
+    return index;
+}
+
+/**
+ * Frees the index.
+ * @param index
+ */
+void invertedIndexDelete(InvertedIndex* index)
+{
+    for (int i = 0; i < index->numTerms; i++)
+    {
+        free(index->lists[i].bytes);
+    }
+    free(index->lists);
+    hashMapDelete(index->terms);
+    free(index);
+}
+
+/**
+ * Decodes every position of the word.
+ * @param index
+ * @param word
+ * @param postings Set to an allocated array of the postings in (document,
+ *                 offset) order, or NULL if the word is not indexed.
+ * @return Number of postings.
+ */
+int invertedIndexPostings(InvertedIndex* index, const char* word,
+                          Posting** postings)
+{
+    int* id = hashMapGet(index->terms, word);
+    *postings = NULL;
+    if (id == NULL)
+    {
+        return 0;
+    }
+    PostingList* list = &index->lists[*id];
+    Posting* out = malloc(sizeof(Posting) * list->numPostings);
+    assert(out != 0);
+    int pos = 0;
+    int document = -1;
+    int offset = 0;
+    for (int i = 0; i < list->numPostings; i++)
+    {
+        uint32_t documentDelta = getVarint(list->bytes, &pos);
+        uint32_t offsetDelta = getVarint(list->bytes, &pos);
+        if (documentDelta == 0)
+        {
+            offset += (int)offsetDelta;
+        }
+        else
+        {
+            document += (int)documentDelta;
+            offset = (int)offsetDelta;
+        }
+        out[i].document = document;
+        out[i].offset = offset;
+    }
+    *postings = out;
+    return list->numPostings;
+}
+
+/**
+ * Decodes the distinct documents of a posting list, skipping positions.
+ * @param list
+ * @return Allocated array of list->numDocuments ascending documents.
+ */
+static int* decodeDocuments(PostingList* list)
+{
+    int* documents = malloc(sizeof(int) * (list->numDocuments + 1));
+    assert(documents != 0);
+    int pos = 0;
+    int document = -1;
+    int n = 0;
+    for (int i = 0; i < list->numPostings; i++)
+    {
+        uint32_t documentDelta = getVarint(list->bytes, &pos);
+        while (list->bytes[pos++] & 0x80)
+        {
+            /* Skip the offset */
+        }
+        if (documentDelta != 0)
+        {
+            document += (int)documentDelta;
+            documents[n++] = document;
+        }
+    }
+    return documents;
+}
+
+/**
+ * Returns the first index in [low, size) whose value is at least target,
+ * probing 1, 2, 4, ... ahead before a binary search.
+ */
+static int gallop(const int* values, int low, int size, int target)
+{
+    int step = 1;
+    int high = low;
+    while (high < size && values[high] < target)
+    {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+    if (high > size)
+    {
+        high = size;
+    }
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (values[mid] < target)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static int compareListSize(const void* left, const void* right)
+{
+    const PostingList* a = *(PostingList* const*)left;
+    const PostingList* b = *(PostingList* const*)right;
+    return a->numDocuments - b->numDocuments;
+}
+
+/**
+ * Finds the documents that contain every one of the given words. The lists
+ * are intersected from the rarest word up, galloping through the longer
+ * lists, so the cost follows the rarest word rather than the most common.
+ * @param index
+ * @param words
+ * @param numWords
+ * @param documents Set to an allocated array of matching documents in
+ *                  ascending order.
+ * @return Number of matching documents.
+ */
+int invertedIndexQuery(InvertedIndex* index, const char** words,
+                       int numWords, int** documents)
+{
+    assert(numWords > 0);
+    PostingList** lists = malloc(sizeof(PostingList*) * numWords);
+    assert(lists != 0);
+    for (int i = 0; i < numWords; i++)
+    {
+        int* id = hashMapGet(index->terms, words[i]);
+        if (id == NULL)
+        {
+            free(lists);
+            *documents = malloc(sizeof(int));
+            assert(*documents != 0);
+            return 0;
+        }
+        lists[i] = &index->lists[*id];
+    }
+    qsort(lists, numWords, sizeof(PostingList*), compareListSize);
+    
+    int* result = decodeDocuments(lists[0]);
+    int size = lists[0]->numDocuments;
+    for (int i = 1; i < numWords && size > 0; i++)
+    {
+        int* other = decodeDocuments(lists[i]);
+        int otherSize = lists[i]->numDocuments;
+        int kept = 0;
+        int j = 0;
+        for (int k = 0; k < size && j < otherSize; k++)
+        {
+            j = gallop(other, j, otherSize, result[k]);
+            if (j < otherSize && other[j] == result[k])
+            {
+                result[kept++] = result[k];
+            }
+        }
+        size = kept;
+        free(other);
+    }
+    free(lists);
+    *documents = result;
+    return size;
+}
+
+/**
+ * Returns the number of distinct words in the index.
+ * @param index
+ * @return Number of terms.
+ */
+int invertedIndexNumTerms(InvertedIndex* index)
+{
+    return index->numTerms;
+}
+
+/**
+ * Returns the number of documents indexed.
+ * @param index
+ * @return Number of documents.
+ */
+int invertedIndexNumDocuments(InvertedIndex* index)
+{
+    return index->numDocuments;
+}
+
+/**
+ * Returns the total number of word positions in the index.
+ * @param index
+ * @return Number of postings.
+ */
+long invertedIndexNumPostings(InvertedIndex* index)
+{
+    long total = 0;
+    for (int i = 0; i < index->numTerms; i++)
+    {
+        total += index->lists[i].numPostings;
+    }
+    return total;
+}
+
+/**
+ * Returns the number of bytes used by the compressed posting lists.
+ * @param index
+ * @return Size of the posting lists in bytes.
+ */
+long invertedIndexPostingBytes(InvertedIndex* index)
+{
+    long total = 0;
+    for (int i = 0; i < index->numTerms; i++)
+    {
+        total += index->lists[i].length;
+    }
+    return total;
+}
@@ -0,0 +1,33 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Positional inverted index over a set of text files.
+ */
+
+#ifndef INVERTED_INDEX_H
+#define INVERTED_INDEX_H
+
+typedef struct InvertedIndex InvertedIndex;
+typedef struct Posting Posting;
+
+struct Posting
+{
+    int document;
+    int offset;     /* Word position within the document */
+};
+
+InvertedIndex* invertedIndexBuild(const char** fileNames, int numFiles,
+                                  int numThreads, int foldCase);
+void invertedIndexDelete(InvertedIndex* index);
+
+int invertedIndexPostings(InvertedIndex* index, const char* word,
+                          Posting** postings);
+int invertedIndexQuery(InvertedIndex* index, const char** words,
+                       int numWords, int** documents);
+
+int invertedIndexNumTerms(InvertedIndex* index);
+int invertedIndexNumDocuments(InvertedIndex* index);
+long invertedIndexNumPostings(InvertedIndex* index);
+long invertedIndexPostingBytes(InvertedIndex* index);
+
+#endif
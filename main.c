@@ -7,59 +7,90 @@
  */
 
 #include "hashMap.h"
+#include "hashMapMerge.h"
+#include "ngram.h"
+#include "tokenizer.h"
+#include "checkpoint.h"
+#include "profiler.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <assert.h>
 
+#define WORD_BATCH 1024
+
 /**
- * Allocates a string for the next word in the file and returns it. This string
- * is null terminated. Returns NULL after reaching the end of the file.
- * @param file
- * @return Allocated string or NULL.
+ * Combines two counts of the same word when merging maps.
+ * @param dstCount
+ * @param srcCount
+ * @return Their sum.
  */
-char* nextWord(FILE* file)
+static int sumCounts(int dstCount, int srcCount)
 {
-    int maxLength = 16;
-    int length = 0;
-    char* word = malloc(sizeof(char) * maxLength);
-    
-    while (1)
+    return dstCount + srcCount;
+}
+
+/**
+ * Prints the n-gram counts of the given file and performance information.
+ * @param fileName
+ * @param n Number of words per n-gram.
+ * @param foldCase 1 to case fold words before counting.
+ * @param timer Clock value at the start of the run.
+ * @return Exit status.
+ */
+static int ngramConcordance(const char* fileName, int n, int foldCase,
+                            clock_t timer)
+{
+    NgramCounter* counter = ngramNew(n);
+    FILE* file = fopen(fileName, "r");
+    if (file == NULL)
     {
-        char c = fgetc(file);
-        if ((c >= '0' && c <= '9') ||
-            (c >= 'A' && c <= 'Z') ||
-            (c >= 'a' && c <= 'z') ||
-            c == '\'')
-        {
-            if (length + 1 >= maxLength)
-            {
-                maxLength *= 2;
-                word = realloc(word, maxLength);
-            }
-            word[length] = c;
-            length++;
-        }
-        else if (length > 0 || c == EOF)
-        {
-            break;
-        }
+        printf("File does not exist.\n");
+        ngramDelete(counter);
+        return 1;
     }
-    if (length == 0)
+    Tokenizer* tokenizer = tokenizerNew(file, foldCase);
+    char* word;
+    int ok = 1;
+    while (ok && (word = tokenizerNext(tokenizer)) != NULL)
     {
+        ok = ngramAddWord(counter, word);
         free(word);
-        return NULL;
     }
-    word[length] = '\0';
+    tokenizerDelete(tokenizer);
+    fclose(file);
+    if (!ok)
+    {
+        printf("Too many distinct words for %d-grams.\n", n);
+        ngramDelete(counter);
+        return 1;
+    }
     
-    return word;
+    ngramPrint(counter);
+    
+    timer = clock() - timer;
+    printf("\nRan in %f seconds\n", (float)timer / (float)CLOCKS_PER_SEC);
+    printf("Distinct words: %d\n", ngramVocabularySize(counter));
+    printf("Distinct %d-grams: %d\n", n, ngramSize(counter));
+    
+    ngramDelete(counter);
+    return 0;
 }
 
 /**
  * Prints the concordance of the given file and performance information. Uses
  * the file input1.txt by default or a file name specified as a command line
- * argument.
+ * argument. An optional second argument n in [2, NGRAM_MAX_N] counts n-grams of
+ * consecutive words instead of single words, and cannot be combined with -c or
+ * -p. The option -f case folds words, so differently capitalized words are
+ * counted together. The option -c checkpointFile resumes counting from the
+ * offset and counts saved in the checkpoint, so an append-only file is only
+ * tokenized from where the last run stopped, and saves the new offset and
+ * counts when done. A word cut off by the end of the file is printed but not
+ * saved; the next run tokenizes it again, in case appended text extends it.
+ * When built with -DPROFILE, the run summary includes time per phase and the
+ * option -p jsonFile also writes it as JSON.
  * @param argc
  * @param argv
  * @return
@@ -68,15 +99,77 @@ int main(int argc, const char** argv)
 {
     // FIXME: implement
     const char* fileName = "input3.txt";
-    if (argc > 1)
+    int n = 1;
+    int foldCase = 0;
+    const char* checkpointName = NULL;
+    const char* profileName = NULL;
+    int positional = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0)
+        {
+            foldCase = 1;
+        }
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            checkpointName = argv[++i];
+        }
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            profileName = argv[++i];
+        }
+        else if (positional++ == 0)
+        {
+            fileName = argv[i];
+        }
+        else
+        {
+            n = (int) strtol(argv[i], NULL, 10);
+        }
+    }
+    if (n < 1 || n > NGRAM_MAX_N)
+    {
+        printf("n must be between 1 and %d.\n", NGRAM_MAX_N);
+        return 1;
+    }
+    if (n > 1 && (checkpointName != NULL || profileName != NULL))
     {
-        fileName = argv[1];
+        printf("Usage: %s [-f] [-c checkpointFile] [-p jsonFile] [file]\n"
+               "       %s [-f] file n\n"
+               "-c and -p only apply when counting single words.\n",
+               argv[0], argv[0]);
+        return 1;
     }
     printf("Opening file: %s\n", fileName);
     
     clock_t timer = clock();
     
+    if (n > 1)
+    {
+        return ngramConcordance(fileName, n, foldCase, timer);
+    }
+    
     HashMap* map = hashMapNew(10);
+    HashMap* saved = NULL;
+    long offset = 0;
+    
+    /* Resume from the checkpoint if it matches this run's options. New words
+     * are counted in a map of their own, which stays small, and merged into
+     * the saved counts at the end. */
+    if (checkpointName != NULL)
+    {
+        int savedFoldCase;
+        saved = checkpointLoad(checkpointName, &offset, &savedFoldCase);
+        if (saved != NULL && savedFoldCase != foldCase)
+        {
+            hashMapDelete(saved);
+            saved = NULL;
+        }
+        if (saved == NULL)
+        {
+            offset = 0;
+        }
+    }
     
     // --- Concordance code begins here ---
     
@@ -85,35 +178,109 @@ int main(int argc, const char** argv)
     
     if((file = fopen(fileName, "r"))) /* If file opens. */
     {
-        do
+        /* A file shorter than the checkpoint was replaced, start over. */
+        fseek(file, 0, SEEK_END);
+        if (ftell(file) < offset && saved != NULL)
         {
-            word = nextWord(file); /* Get next word */
-            int value = 0;
+            hashMapDelete(saved);
+            saved = NULL;
+            offset = 0;
+        }
+        fseek(file, offset, SEEK_SET);
         
-            if(word) /* If word is not null. */
+        Tokenizer* tokenizer = tokenizerNew(file, foldCase);
+        char* batch[WORD_BATCH];
+        char* tail = NULL;
+        int batchSize;
+        do
+        {
+            /* Tokenize a batch of words, then count them, so each profiled
+             * phase covers many words. */
+            PROFILE_BEGIN(PHASE_TOKENIZE);
+            for (batchSize = 0; batchSize < WORD_BATCH; batchSize++)
             {
-                if(hashMapContainsKey(map, word)) /* If already in map, increment value. */
+                word = tokenizerNext(tokenizer); /* Get next word */
+                
+                /* With a checkpoint, a word cut off by the end of the file
+                 * is kept out of the saved counts, since appended text could
+                 * extend it. It is counted after saving. */
+                if (word && checkpointName != NULL &&
+                    !tokenizerIsWordFinal(tokenizer))
                 {
-                    value = *hashMapGet(map, word);
-                    value++;
-                    hashMapPut(map, word, value);
+                    tail = word;
+                    word = NULL;
                 }
-                else                             /* Else add new value to the map. */
-                    hashMapPut(map, word, 1);
-
-                free(word);
+                if (word == NULL)
+                {
+                    break;
+                }
+                batch[batchSize] = word;
+            }
+            PROFILE_COUNT(PHASE_TOKENIZE, 0, batchSize);
+            PROFILE_END(PHASE_TOKENIZE);
+            
+            PROFILE_BEGIN(PHASE_HASH);
+            for (int i = 0; i < batchSize; i++)
+            {
+                int* value = hashMapGet(map, batch[i]);
+                if(value) /* If already in map, increment value in place. */
+                {
+                    ++(*value);
+                }
+                else      /* Else add new value to the map. */
+                    hashMapPut(map, batch[i], 1);
+                free(batch[i]);
             }
+            PROFILE_COUNT(PHASE_HASH, 0, batchSize);
+            PROFILE_END(PHASE_HASH);
         }while(word != NULL);
         
-        free(word);  /* Free last word and close file. */
-        fclose(file);
+        if (saved != NULL)
+        {
+            hashMapMerge(saved, map, sumCounts);
+            hashMapDelete(map);
+            map = saved;
+            saved = NULL;
+        }
+        
+        if (checkpointName != NULL &&
+            !checkpointSave(checkpointName, map,
+                            tokenizerCommittedOffset(tokenizer), foldCase))
+        {
+            printf("Could not save checkpoint: %s\n", checkpointName);
+        }
+        
+        /* The next run tokenizes the tail again from the saved offset. */
+        if (tail != NULL)
+        {
+            int* value = hashMapGet(map, tail);
+            if (value)
+            {
+                ++(*value);
+            }
+            else
+            {
+                hashMapPut(map, tail, 1);
+            }
+            free(tail);
+        }
+        tokenizerDelete(tokenizer);
+        fclose(file);   /* Close file. */
     }
     else
         printf("File does not exist.\n");
+    if (saved != NULL)
+    {
+        hashMapDelete(map);
+        map = saved;
+    }
     
     // --- Concordance code ends here ---
     
+    PROFILE_BEGIN(PHASE_PRINT);
     hashMapPrint(map);
+    PROFILE_COUNT(PHASE_PRINT, 0, hashMapSize(map));
+    PROFILE_END(PHASE_PRINT);
     
     timer = clock() - timer;
     printf("\nRan in %f seconds\n", (float)timer / (float)CLOCKS_PER_SEC);
@@ -121,6 +288,17 @@ int main(int argc, const char** argv)
     printf("Number of links: %d\n", hashMapSize(map));
     printf("Number of buckets: %d\n", hashMapCapacity(map));
     printf("Table load: %f\n", hashMapTableLoad(map));
+    PROFILE_REPORT(stdout);
+    if (profileName != NULL && !PROFILE_JSON(profileName))
+    {
+        printf("Profile not written: %s%s\n", profileName,
+#ifdef PROFILE
+               ""
+#else
+               " (build with -DPROFILE)"
+#endif
+               );
+    }
     
     hashMapDelete(map);
     return 0;
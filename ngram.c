@@ -0,0 +1,364 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * NgramCounter implementation file.
+ *
+ * Each distinct word is interned once into a dense integer id using a
+ * HashMap from word to id. An n-gram is then the tuple of its word ids packed
+ * into one 64-bit integer, 64 / n bits per id, and counted in an open
+ * addressing table keyed by that integer. Counting an n-gram costs one word
+ * lookup plus a few integer operations instead of building and hashing a
+ * "word1 word2" string.
+ */
+
+#include "ngram.h"
+#include "hashMap.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define MAX_COUNT_LOAD 0.5
+
+typedef struct CountSlot CountSlot;
+
+struct CountSlot
+{
+    uint64_t key;
+    int count;      /* 0 marks an empty slot */
+};
+
+struct NgramCounter
+{
+    int n;
+    int bitsPerId;
+    HashMap* ids;
+    uint32_t window[NGRAM_MAX_N];
+    int windowSize;
+    CountSlot* slots;
+    int capacity;   /* Always a power of two */
+    int size;
+};
+
+/**
+ * Multiplicative hash of a packed key into a table of the given capacity.
+ * @param key
+ * @param capacity Power of two.
+ * @return Slot index.
+ */
+static int slotIndex(uint64_t key, int capacity)
+{
+    key ^= key >> 29;
+    key *= 0x9e3779b97f4a7c15ull;
+    return (int)((key >> 32) & (uint64_t)(capacity - 1));
+}
+
+/**
+ * Returns the slot holding the key, or the empty slot where it belongs.
+ * @param slots
+ * @param capacity
+ * @param key
+ * @return The slot.
+ */
+static CountSlot* findSlot(CountSlot* slots, int capacity, uint64_t key)
+{
+    int i = slotIndex(key, capacity);
+    while (slots[i].count != 0 && slots[i].key != key)
+    {
+        i = (i + 1) & (capacity - 1);
+    }
+    return &slots[i];
+}
+
+/**
+ * Doubles the count table and reinserts every n-gram.
+ * @param counter
+ */
+static void growTable(NgramCounter* counter)
+{
+    int capacity = counter->capacity * 2;
+    CountSlot* slots = calloc(capacity, sizeof(CountSlot));
+    assert(slots != 0);
+    for (int i = 0; i < counter->capacity; i++)
+    {
+        if (counter->slots[i].count != 0)
+        {
+            *findSlot(slots, capacity, counter->slots[i].key) =
+                counter->slots[i];
+        }
+    }
+    free(counter->slots);
+    counter->slots = slots;
+    counter->capacity = capacity;
+}
+
+/**
+ * Packs the ids of the current window into one key, oldest word in the high
+ * bits.
+ * @param counter
+ * @param ids
+ * @return Packed key.
+ */
+static uint64_t packIds(NgramCounter* counter, const uint32_t* ids)
+{
+    uint64_t key = 0;
+    for (int i = 0; i < counter->n; i++)
+    {
+        key = (counter->bitsPerId == 64 ? 0 : key << counter->bitsPerId)
+            | ids[i];
+    }
+    return key;
+}
+
+/**
+ * Finds the id of the word, interning it if it has not been seen.
+ * @param counter
+ * @param word
+ * @param id Set to the dense word id.
+ * @return 1 on success, 0 if a new word would not fit in the id bits.
+ */
+static int internWord(NgramCounter* counter, const char* word, uint32_t* id)
+{
+    int* found = hashMapGet(counter->ids, word);
+    if (found != NULL)
+    {
+        *id = (uint32_t)*found;
+        return 1;
+    }
+    int newId = hashMapSize(counter->ids);
+    if (counter->bitsPerId < 32 && (uint64_t)newId >> counter->bitsPerId)
+    {
+        return 0;
+    }
+    hashMapPut(counter->ids, word, newId);
+    *id = (uint32_t)newId;
+    return 1;
+}
+
+/**
+ * Allocates a counter for n-grams of n words.
+ * @param n Number of words per n-gram, in [1, NGRAM_MAX_N].
+ * @return The counter.
+ */
+NgramCounter* ngramNew(int n)
+{
+    assert(n >= 1 && n <= NGRAM_MAX_N);
+    NgramCounter* counter = malloc(sizeof(NgramCounter));
+    assert(counter != 0);
+    counter->n = n;
+    counter->bitsPerId = 64 / n;
+    counter->ids = hashMapNew(1024);
+    counter->windowSize = 0;
+    counter->capacity = 1024;
+    counter->size = 0;
+    counter->slots = calloc(counter->capacity, sizeof(CountSlot));
+    assert(counter->slots != 0);
+    return counter;
+}
+
+/**
+ * Frees the counter, its word dictionary and its count table.
+ * @param counter
+ */
+void ngramDelete(NgramCounter* counter)
+{
+    hashMapDelete(counter->ids);
+    free(counter->slots);
+    free(counter);
+}
+
+/**
+ * Appends the next word of the text and counts the n-gram ending at it once
+ * n words have been seen.
+ * @param counter
+ * @param word
+ * @return 1 on success, 0 if the vocabulary has outgrown the 64 / n bits
+ * each word id is packed into. The counter is unchanged on failure.
+ */
+int ngramAddWord(NgramCounter* counter, const char* word)
+{
+    uint32_t id;
+    if (!internWord(counter, word, &id))
+    {
+        return 0;
+    }
+    if (counter->windowSize == counter->n)
+    {
+        memmove(counter->window, counter->window + 1,
+                sizeof(uint32_t) * (counter->n - 1));
+        counter->windowSize--;
+    }
+    counter->window[counter->windowSize++] = id;
+    if (counter->windowSize < counter->n)
+    {
+        return 1;
+    }
+    
+    if (counter->size + 1 > counter->capacity * MAX_COUNT_LOAD)
+    {
+        growTable(counter);
+    }
+    uint64_t key = packIds(counter, counter->window);
+    CountSlot* slot = findSlot(counter->slots, counter->capacity, key);
+    if (slot->count == 0)
+    {
+        slot->key = key;
+        counter->size++;
+    }
+    slot->count++;
+    return 1;
+}
+
+/**
+ * Starts a new word sequence, so no n-gram spans the break (for example
+ * between two input files).
+ * @param counter
+ */
+void ngramBreak(NgramCounter* counter)
+{
+    counter->windowSize = 0;
+}
+
+/**
+ * Returns the count of the n-gram made of the given n words.
+ * @param counter
+ * @param words Array of n words.
+ * @return Number of occurrences, 0 if never seen.
+ */
+int ngramGet(NgramCounter* counter, const char** words)
+{
+    uint32_t ids[NGRAM_MAX_N];
+    for (int i = 0; i < counter->n; i++)
+    {
+        int* id = hashMapGet(counter->ids, words[i]);
+        if (id == NULL)
+        {
+            return 0;
+        }
+        ids[i] = (uint32_t)*id;
+    }
+    uint64_t key = packIds(counter, ids);
+    return findSlot(counter->slots, counter->capacity, key)->count;
+}
+
+/**
+ * Returns the number of distinct n-grams counted.
+ * @param counter
+ * @return Number of distinct n-grams.
+ */
+int ngramSize(NgramCounter* counter)
+{
+    return counter->size;
+}
+
+/**
+ * Returns the number of distinct words seen.
+ * @param counter
+ * @return Number of distinct words.
+ */
+int ngramVocabularySize(NgramCounter* counter)
+{
+    return hashMapSize(counter->ids);
+}
+
+/**
+ * Writes every n-gram with its count in the writer's format. Text writes one
+ * (words, count) line per n-gram, CSV writes an ngram,count row, and binary
+ * writes the n-gram count followed by each n-gram and its count.
+ * @param counter
+ * @param writer
+ */
+void ngramReport(NgramCounter* counter, ReportWriter* writer)
+{
+    /* Map ids back to the words stored in the dictionary links. */
+    HashMap* ids = counter->ids;
+    const char** words = malloc(sizeof(char*) * (hashMapSize(ids) + 1));
+    assert(words != 0);
+    for (int i = 0; i < ids->capacity; i++)
+    {
+        for (HashLink* link = ids->table[i]; link != NULL; link = link->next)
+        {
+            words[link->value] = link->key;
+        }
+    }
+    
+    ReportFormat format = reportFormat(writer);
+    if (format == REPORT_CSV)
+    {
+        reportWriteString(writer, "ngram,count\n");
+    }
+    else if (format == REPORT_BINARY)
+    {
+        reportWriteBinaryInt(writer, counter->size);
+    }
+    
+    /* The n-gram is joined into one buffer so CSV can quote it as a field. */
+    size_t capacity = 64;
+    char* ngram = malloc(capacity);
+    assert(ngram != 0);
+    uint64_t mask = counter->bitsPerId == 64
+        ? ~0ull : (1ull << counter->bitsPerId) - 1;
+    for (int i = 0; i < counter->capacity; i++)
+    {
+        CountSlot* slot = &counter->slots[i];
+        if (slot->count == 0)
+        {
+            continue;
+        }
+        size_t length = 0;
+        for (int j = counter->n - 1; j >= 0; j--)
+        {
+            uint64_t id = counter->bitsPerId == 64
+                ? slot->key : (slot->key >> (j * counter->bitsPerId)) & mask;
+            size_t wordLength = strlen(words[id]);
+            if (length + wordLength + 2 > capacity)
+            {
+                capacity = (length + wordLength + 2) * 2;
+                ngram = realloc(ngram, capacity);
+                assert(ngram != 0);
+            }
+            if (j != counter->n - 1)
+            {
+                ngram[length++] = ' ';
+            }
+            memcpy(ngram + length, words[id], wordLength);
+            length += wordLength;
+        }
+        ngram[length] = '\0';
+        
+        if (format == REPORT_TEXT)
+        {
+            reportWriteChar(writer, '(');
+            reportWriteString(writer, ngram);
+            reportWriteString(writer, ", ");
+            reportWriteInt(writer, slot->count);
+            reportWriteString(writer, ")\n");
+        }
+        else if (format == REPORT_CSV)
+        {
+            reportWriteCsvField(writer, ngram);
+            reportWriteChar(writer, ',');
+            reportWriteInt(writer, slot->count);
+            reportWriteChar(writer, '\n');
+        }
+        else
+        {
+            reportWriteBinaryString(writer, ngram);
+            reportWriteBinaryInt(writer, slot->count);
+        }
+    }
+    free(ngram);
+    free(words);
+}
+
+/**
+ * Prints every n-gram with its count.
+ * @param counter
+ */
+void ngramPrint(NgramCounter* counter)
+{
+    ReportWriter* writer = reportWriterNew(stdout, REPORT_TEXT);
+    ngramReport(counter, writer);
+    reportWriterDelete(writer);
+}
@@ -0,0 +1,28 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * N-gram frequency counter for the concordance program.
+ */
+
+#ifndef NGRAM_H
+#define NGRAM_H
+
+#include "reportWriter.h"
+
+#define NGRAM_MAX_N 3
+
+typedef struct NgramCounter NgramCounter;
+
+NgramCounter* ngramNew(int n);
+void ngramDelete(NgramCounter* counter);
+
+int ngramAddWord(NgramCounter* counter, const char* word);
+void ngramBreak(NgramCounter* counter);
+int ngramGet(NgramCounter* counter, const char** words);
+
+int ngramSize(NgramCounter* counter);
+int ngramVocabularySize(NgramCounter* counter);
+void ngramReport(NgramCounter* counter, ReportWriter* writer);
+void ngramPrint(NgramCounter* counter);
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Profiler implementation file.
+ *
+ * Phases nest: time spent in a phase begun inside another one (reading a
+ * block while tokenizing, resizing while hashing) is charged to the inner
+ * phase only, so the phase times add up to the profiled total. Each begin or
+ * end reads the wall and CPU clocks once, so phases should be entered per
+ * batch of work rather than per word.
+ *
+ * Library code such as the tokenizer and hash map may run on several threads
+ * at once, so each thread keeps its own phase stack and statistics, and
+ * charges CPU time from its own clock. The reports add up all threads, so
+ * with several threads the wall times are thread-seconds and may exceed the
+ * elapsed time. Report only after the profiled threads have finished.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "profiler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+#include <pthread.h>
+
+#define MAX_DEPTH 16
+
+typedef struct PhaseStats PhaseStats;
+
+struct PhaseStats
+{
+    double wallSeconds;
+    double cpuSeconds;
+    long entries;
+    long bytes;
+    long items;
+};
+
+static const char* phaseNames[PHASE_COUNT] =
+{
+    "io", "tokenize", "hash", "resize", "print"
+};
+
+typedef struct ThreadProfile ThreadProfile;
+
+/**
+ * Profiler state of one thread. Every thread's state is kept in the list at
+ * profiles, so it can still be reported after the thread exits.
+ */
+struct ThreadProfile
+{
+    PhaseStats stats[PHASE_COUNT];
+    ProfilePhase stack[MAX_DEPTH];
+    int depth;
+    double lastWall;
+    double lastCpu;
+    ThreadProfile* next;
+};
+
+static _Thread_local ThreadProfile* threadState = NULL;
+static ThreadProfile* profiles = NULL;
+static pthread_mutex_t profilesLock = PTHREAD_MUTEX_INITIALIZER;
+
+static double readClock(clockid_t clock)
+{
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Returns the calling thread's profiler state, creating it on first use.
+ * @return The state.
+ */
+static ThreadProfile* threadProfile(void)
+{
+    if (threadState == NULL)
+    {
+        threadState = calloc(1, sizeof(ThreadProfile));
+        assert(threadState != 0);
+        pthread_mutex_lock(&profilesLock);
+        threadState->next = profiles;
+        profiles = threadState;
+        pthread_mutex_unlock(&profilesLock);
+    }
+    return threadState;
+}
+
+/**
+ * Adds up the statistics of every thread.
+ * @param total Set to the sum for each phase.
+ */
+static void mergeStats(PhaseStats* total)
+{
+    memset(total, 0, sizeof(PhaseStats) * PHASE_COUNT);
+    pthread_mutex_lock(&profilesLock);
+    for (ThreadProfile* p = profiles; p != NULL; p = p->next)
+    {
+        for (int i = 0; i < PHASE_COUNT; i++)
+        {
+            total[i].wallSeconds += p->stats[i].wallSeconds;
+            total[i].cpuSeconds += p->stats[i].cpuSeconds;
+            total[i].entries += p->stats[i].entries;
+            total[i].bytes += p->stats[i].bytes;
+            total[i].items += p->stats[i].items;
+        }
+    }
+    pthread_mutex_unlock(&profilesLock);
+}
+
+/**
+ * Charges the time since the thread's last begin or end to its innermost
+ * open phase.
+ * @param profile The calling thread's state.
+ */
+static void charge(ThreadProfile* profile)
+{
+    double wall = readClock(CLOCK_MONOTONIC);
+    double cpu = readClock(CLOCK_THREAD_CPUTIME_ID);
+    if (profile->depth > 0)
+    {
+        PhaseStats* current =
+            &profile->stats[profile->stack[profile->depth - 1]];
+        current->wallSeconds += wall - profile->lastWall;
+        current->cpuSeconds += cpu - profile->lastCpu;
+    }
+    profile->lastWall = wall;
+    profile->lastCpu = cpu;
+}
+
+/**
+ * Starts timing a phase, pausing the enclosing one.
+ * @param phase
+ */
+void profilerBegin(ProfilePhase phase)
+{
+    ThreadProfile* profile = threadProfile();
+    assert(profile->depth < MAX_DEPTH);
+    charge(profile);
+    profile->stack[profile->depth++] = phase;
+    profile->stats[phase].entries++;
+}
+
+/**
+ * Stops timing a phase and resumes the enclosing one.
+ * @param phase Must be the innermost open phase.
+ */
+void profilerEnd(ProfilePhase phase)
+{
+    ThreadProfile* profile = threadProfile();
+    assert(profile->depth > 0 &&
+           profile->stack[profile->depth - 1] == phase);
+    charge(profile);
+    profile->depth--;
+}
+
+/**
+ * Adds to the amount of work done in a phase, for throughput.
+ * @param phase
+ * @param bytes Bytes processed, or 0.
+ * @param items Words, links or other units processed, or 0.
+ */
+void profilerCount(ProfilePhase phase, long bytes, long items)
+{
+    ThreadProfile* profile = threadProfile();
+    profile->stats[phase].bytes += bytes;
+    profile->stats[phase].items += items;
+}
+
+/**
+ * Prints a table of the phases, summed over all threads, with their times
+ * and throughput.
+ * @param file
+ */
+void profilerReport(FILE* file)
+{
+    PhaseStats stats[PHASE_COUNT];
+    mergeStats(stats);
+    double totalWall = 0;
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        totalWall += stats[i].wallSeconds;
+    }
+    fprintf(file, "\n%-9s %10s %10s %6s %12s %12s %10s %12s\n", "Phase",
+            "Wall (s)", "CPU (s)", "Wall%", "Bytes", "Items", "MB/s",
+            "Items/s");
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        PhaseStats* s = &stats[i];
+        if (s->entries == 0)
+        {
+            continue;
+        }
+        double mbPerSecond = s->wallSeconds > 0
+            ? s->bytes / s->wallSeconds / 1e6 : 0;
+        double itemsPerSecond = s->wallSeconds > 0
+            ? s->items / s->wallSeconds : 0;
+        fprintf(file, "%-9s %10.6f %10.6f %5.1f%% %12ld %12ld %10.1f %12.0f\n",
+                phaseNames[i], s->wallSeconds, s->cpuSeconds,
+                totalWall > 0 ? 100 * s->wallSeconds / totalWall : 0.0,
+                s->bytes, s->items, mbPerSecond, itemsPerSecond);
+    }
+}
+
+/**
+ * Writes the phase statistics, summed over all threads, as a JSON object
+ * keyed by phase name.
+ * @param fileName
+ * @return 1 on success, 0 if the file could not be written.
+ */
+int profilerJson(const char* fileName)
+{
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    PhaseStats stats[PHASE_COUNT];
+    mergeStats(stats);
+    fprintf(file, "{\n  \"phases\": {");
+    int first = 1;
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        PhaseStats* s = &stats[i];
+        if (s->entries == 0)
+        {
+            continue;
+        }
+        fprintf(file, "%s\n    \"%s\": {\"wall_seconds\": %.9f, "
+                "\"cpu_seconds\": %.9f, \"entries\": %ld, \"bytes\": %ld, "
+                "\"items\": %ld, \"bytes_per_second\": %.1f, "
+                "\"items_per_second\": %.1f}",
+                first ? "" : ",", phaseNames[i], s->wallSeconds,
+                s->cpuSeconds, s->entries, s->bytes, s->items,
+                s->wallSeconds > 0 ? s->bytes / s->wallSeconds : 0.0,
+                s->wallSeconds > 0 ? s->items / s->wallSeconds : 0.0);
+        first = 0;
+    }
+    fprintf(file, "\n  }\n}\n");
+    return fclose(file) == 0;
+}
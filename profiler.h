@@ -0,0 +1,45 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Per-phase profiler for the concordance program. Compile with -DPROFILE to
+ * enable it; otherwise every PROFILE_ macro expands to nothing.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdio.h>
+
+typedef enum ProfilePhase ProfilePhase;
+
+enum ProfilePhase
+{
+    PHASE_IO,
+    PHASE_TOKENIZE,
+    PHASE_HASH,
+    PHASE_RESIZE,
+    PHASE_PRINT,
+    PHASE_COUNT
+};
+
+void profilerBegin(ProfilePhase phase);
+void profilerEnd(ProfilePhase phase);
+void profilerCount(ProfilePhase phase, long bytes, long items);
+void profilerReport(FILE* file);
+int profilerJson(const char* fileName);
+
+#ifdef PROFILE
+#define PROFILE_BEGIN(phase) profilerBegin(phase)
+#define PROFILE_END(phase) profilerEnd(phase)
+#define PROFILE_COUNT(phase, bytes, items) profilerCount(phase, bytes, items)
+#define PROFILE_REPORT(file) profilerReport(file)
+#define PROFILE_JSON(fileName) profilerJson(fileName)
+#else
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+#define PROFILE_COUNT(phase, bytes, items) ((void)0)
+#define PROFILE_REPORT(file) ((void)0)
+#define PROFILE_JSON(fileName) (0)
+#endif
+
+#endif
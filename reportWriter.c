@@ -0,0 +1,258 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * ReportWriter implementation file.
+ *
+ * Output is formatted straight into a large buffer and handed to the file in
+ * buffer-sized fwrite calls, which stdio passes through as single writes.
+ * That replaces one printf, with its format parsing and stream locking, per
+ * value. Integers are formatted two digits at a time from a lookup table.
+ */
+
+#include "reportWriter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define REPORT_BUFFER_SIZE (1 << 20)
+
+struct ReportWriter
+{
+    FILE* file;
+    ReportFormat format;
+    char* buffer;
+    int length;
+    int failed;     /* 1 once any write to the file has failed */
+};
+
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * Allocates a writer appending to the given file. Anything already written
+ * to the file through stdio keeps its order, since the writer goes through
+ * the same stream.
+ * @param file
+ * @param format Format the report functions should produce.
+ * @return The writer.
+ */
+ReportWriter* reportWriterNew(FILE* file, ReportFormat format)
+{
+    ReportWriter* writer = malloc(sizeof(ReportWriter));
+    assert(writer != 0);
+    writer->file = file;
+    writer->format = format;
+    writer->buffer = malloc(REPORT_BUFFER_SIZE);
+    assert(writer->buffer != 0);
+    writer->length = 0;
+    writer->failed = 0;
+    return writer;
+}
+
+/**
+ * Writes bytes straight to the file, recording a short write.
+ * @param writer
+ * @param bytes
+ * @param length
+ */
+static void writeOut(ReportWriter* writer, const void* bytes, int length)
+{
+    if (fwrite(bytes, 1, length, writer->file) != (size_t)length)
+    {
+        writer->failed = 1;
+    }
+}
+
+/**
+ * Flushes and frees the writer. The file is left open.
+ * @param writer
+ * @return 1 if everything written reached the file, 0 otherwise.
+ */
+int reportWriterDelete(ReportWriter* writer)
+{
+    int ok = reportFlush(writer);
+    free(writer->buffer);
+    free(writer);
+    return ok;
+}
+
+/**
+ * Writes the buffered output to the file.
+ * @param writer
+ * @return 1 if everything written so far reached the file, 0 otherwise.
+ */
+int reportFlush(ReportWriter* writer)
+{
+    if (writer->length > 0)
+    {
+        writeOut(writer, writer->buffer, writer->length);
+        writer->length = 0;
+    }
+    if (fflush(writer->file) != 0)
+    {
+        writer->failed = 1;
+    }
+    return !writer->failed;
+}
+
+/**
+ * Returns the format the writer was created with.
+ * @param writer
+ * @return The report format.
+ */
+ReportFormat reportFormat(ReportWriter* writer)
+{
+    return writer->format;
+}
+
+/**
+ * Makes room for length more bytes, flushing if the buffer is too full.
+ * @param writer
+ * @param length At most REPORT_BUFFER_SIZE.
+ */
+static void reserve(ReportWriter* writer, int length)
+{
+    if (writer->length + length > REPORT_BUFFER_SIZE)
+    {
+        writeOut(writer, writer->buffer, writer->length);
+        writer->length = 0;
+    }
+}
+
+/**
+ * Appends raw bytes.
+ * @param writer
+ * @param bytes
+ * @param length
+ */
+void reportWriteBytes(ReportWriter* writer, const void* bytes, int length)
+{
+    if (length > REPORT_BUFFER_SIZE / 2)
+    {
+        reserve(writer, REPORT_BUFFER_SIZE);
+        writeOut(writer, bytes, length);
+        return;
+    }
+    reserve(writer, length);
+    memcpy(writer->buffer + writer->length, bytes, length);
+    writer->length += length;
+}
+
+/**
+ * Appends a string without its '\0'.
+ * @param writer
+ * @param string
+ */
+void reportWriteString(ReportWriter* writer, const char* string)
+{
+    reportWriteBytes(writer, string, (int)strlen(string));
+}
+
+/**
+ * Appends one character.
+ * @param writer
+ * @param c
+ */
+void reportWriteChar(ReportWriter* writer, char c)
+{
+    reserve(writer, 1);
+    writer->buffer[writer->length++] = c;
+}
+
+/**
+ * Appends an integer in decimal.
+ * @param writer
+ * @param value
+ */
+void reportWriteInt(ReportWriter* writer, long value)
+{
+    char digits[24];
+    char* end = digits + sizeof digits;
+    char* p = end;
+    unsigned long n = value < 0 ? 0ul - (unsigned long)value
+                                : (unsigned long)value;
+    while (n >= 100)
+    {
+        int pair = (int)(n % 100) * 2;
+        n /= 100;
+        *--p = digitPairs[pair + 1];
+        *--p = digitPairs[pair];
+    }
+    if (n >= 10)
+    {
+        *--p = digitPairs[n * 2 + 1];
+        *--p = digitPairs[n * 2];
+    }
+    else
+    {
+        *--p = (char)('0' + n);
+    }
+    if (value < 0)
+    {
+        *--p = '-';
+    }
+    reportWriteBytes(writer, p, (int)(end - p));
+}
+
+/**
+ * Appends a CSV field, quoting it if it contains a comma, quote or line
+ * break.
+ * @param writer
+ * @param field
+ */
+void reportWriteCsvField(ReportWriter* writer, const char* field)
+{
+    if (strpbrk(field, ",\"\r\n") == NULL)
+    {
+        reportWriteString(writer, field);
+        return;
+    }
+    reportWriteChar(writer, '"');
+    for (const char* c = field; *c != '\0'; c++)
+    {
+        if (*c == '"')
+        {
+            reportWriteChar(writer, '"');
+        }
+        reportWriteChar(writer, *c);
+    }
+    reportWriteChar(writer, '"');
+}
+
+/**
+ * Appends a 32-bit integer in little-endian byte order.
+ * @param writer
+ * @param value
+ */
+void reportWriteBinaryInt(ReportWriter* writer, int value)
+{
+    uint32_t v = (uint32_t)value;
+    unsigned char bytes[4];
+    bytes[0] = (unsigned char)v;
+    bytes[1] = (unsigned char)(v >> 8);
+    bytes[2] = (unsigned char)(v >> 16);
+    bytes[3] = (unsigned char)(v >> 24);
+    reportWriteBytes(writer, bytes, 4);
+}
+
+/**
+ * Appends a string as its 32-bit length followed by its bytes.
+ * @param writer
+ * @param string
+ */
+void reportWriteBinaryString(ReportWriter* writer, const char* string)
+{
+    int length = (int)strlen(string);
+    reportWriteBinaryInt(writer, length);
+    reportWriteBytes(writer, string, length);
+}
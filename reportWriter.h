@@ -0,0 +1,36 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Buffered writer for large text, CSV and binary reports.
+ */
+
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <stdio.h>
+
+typedef enum ReportFormat ReportFormat;
+
+enum ReportFormat
+{
+    REPORT_TEXT,
+    REPORT_CSV,
+    REPORT_BINARY
+};
+
+typedef struct ReportWriter ReportWriter;
+
+ReportWriter* reportWriterNew(FILE* file, ReportFormat format);
+int reportWriterDelete(ReportWriter* writer);
+int reportFlush(ReportWriter* writer);
+ReportFormat reportFormat(ReportWriter* writer);
+
+void reportWriteBytes(ReportWriter* writer, const void* bytes, int length);
+void reportWriteString(ReportWriter* writer, const char* string);
+void reportWriteChar(ReportWriter* writer, char c);
+void reportWriteInt(ReportWriter* writer, long value);
+void reportWriteCsvField(ReportWriter* writer, const char* field);
+void reportWriteBinaryInt(ReportWriter* writer, int value);
+void reportWriteBinaryString(ReportWriter* writer, const char* string);
+
+#endif
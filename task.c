@@ -5,6 +5,7 @@
  */
 
 #include "task.h"
+#include "taskReport.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -63,6 +64,36 @@ int taskCompare(void* left, void* right)
         return 0;
 }
 
+/**
+ * Writes a task for dyReport: a (priority, name) pair as text, two fields as
+ * CSV, or the priority and name in binary.
+ * @param writer
+ * @param value  Task pointer.
+ */
+void taskReport(ReportWriter* writer, void* value)
+{
+    Task* task = (Task*)value;
+    switch (reportFormat(writer))
+    {
+        case REPORT_TEXT:
+            reportWriteChar(writer, '(');
+            reportWriteInt(writer, task->priority);
+            reportWriteString(writer, ", ");
+            reportWriteString(writer, task->name);
+            reportWriteChar(writer, ')');
+            break;
+        case REPORT_CSV:
+            reportWriteInt(writer, task->priority);
+            reportWriteChar(writer, ',');
+            reportWriteCsvField(writer, task->name);
+            break;
+        case REPORT_BINARY:
+            reportWriteBinaryInt(writer, task->priority);
+            reportWriteBinaryString(writer, task->name);
+            break;
+    }
+}
+
 /**
  * Prints a task as a (priority, name) pair.
  * @param value  Task pointer.
@@ -0,0 +1,14 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Writing a Task through a ReportWriter, for use with dyReport.
+ */
+
+#ifndef TASK_REPORT_H
+#define TASK_REPORT_H
+
+#include "reportWriter.h"
+
+void taskReport(ReportWriter* writer, void* value);
+
+#endif
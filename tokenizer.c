@@ -0,0 +1,545 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Tokenizer implementation file.
+ *
+ * Splits UTF-8 text into words. A word is a run of ASCII letters, digits and
+ * apostrophes, or of Unicode letters, combining marks and decimal digits.
+ * Malformed UTF-8 (overlong forms, surrogates, code points past U+10FFFF or
+ * truncated sequences) is skipped one byte at a time and acts as a
+ * separator. With case folding on, every word character is replaced by its
+ * simple case folding, so "Straße" and "STRAßE" count as the same word.
+ *
+ * Input is read in large blocks. Runs of pure ASCII are found 16 bytes at a
+ * time with SSE2 and scanned without any UTF-8 decoding, so ASCII-only text
+ * takes the same path as before.
+ *
+ * For files that are still being appended to, the tokenizer tracks the file
+ * offset up to which text is final: a word cut off by the end of the file, or
+ * a truncated UTF-8 sequence there, may continue once more bytes arrive.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tokenizer.h"
+#include "tokenizerTables.h"
+#include "profiler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define BLOCK_SIZE 65536
+#define MAX_SEQUENCE 4
+
+struct Tokenizer
+{
+    FILE* file;
+    int foldCase;
+    int isEof;
+    unsigned char* buffer;
+    int pos;
+    int end;
+    int asciiEnd;      /* Bytes in [pos, asciiEnd) are known to be ASCII */
+    long base;         /* File offset of buffer[0] */
+    long wordStart;    /* File offset of the current word */
+    long committed;    /* File offset up to which words are final */
+    int isWordFinal;
+    char* word;
+    int wordLength;
+    int wordCapacity;
+    long invalidBytes;
+};
+
+/**
+ * Returns the number of leading ASCII bytes in the given range.
+ * @param data
+ * @param length
+ * @return Length of the ASCII prefix.
+ */
+static int asciiPrefixLength(const unsigned char* data, int length)
+{
+    int i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        int mask = _mm_movemask_epi8(chunk);
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (i < length && data[i] < 0x80)
+    {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Decodes and validates one multibyte UTF-8 sequence.
+ * @param s Start of the sequence; s[0] >= 0x80.
+ * @param available Number of readable bytes at s.
+ * @param codePoint Set to the decoded code point.
+ * @return Length of the sequence, or 0 if it is malformed.
+ */
+static int decodeUtf8(const unsigned char* s, int available,
+                      uint32_t* codePoint)
+{
+    unsigned char c = s[0];
+    int length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    
+    if (c >= 0xC2 && c <= 0xDF)
+    {
+        length = 2;
+        *codePoint = c & 0x1F;
+    }
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+        length = 3;
+        *codePoint = c & 0x0F;
+        if (c == 0xE0)
+        {
+            low = 0xA0;     /* Overlong */
+        }
+        else if (c == 0xED)
+        {
+            high = 0x9F;    /* Surrogates */
+        }
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+        length = 4;
+        *codePoint = c & 0x07;
+        if (c == 0xF0)
+        {
+            low = 0x90;     /* Overlong */
+        }
+        else if (c == 0xF4)
+        {
+            high = 0x8F;    /* Past U+10FFFF */
+        }
+    }
+    else
+    {
+        return 0;
+    }
+    
+    if (available < length || s[1] < low || s[1] > high)
+    {
+        return 0;
+    }
+    for (int i = 1; i < length; i++)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        *codePoint = (*codePoint << 6) | (s[i] & 0x3F);
+    }
+    return length;
+}
+
+static int isAsciiWordChar(unsigned char c)
+{
+    return (c >= '0' && c <= '9') ||
+           (c >= 'A' && c <= 'Z') ||
+           (c >= 'a' && c <= 'z') ||
+           c == '\'';
+}
+
+/**
+ * Returns 1 if the code point is a Unicode letter, mark or decimal digit.
+ * @param codePoint
+ * @return 1 if it is part of words, 0 otherwise.
+ */
+static int isWordCodePoint(uint32_t codePoint)
+{
+    uint32_t block = codePoint >> 8;
+    if (block >= WORD_BLOCK_INDEX_SIZE)
+    {
+        return 0;
+    }
+    const uint32_t* bits = wordBlocks[wordBlockIndex[block]];
+    return (bits[(codePoint & 0xFF) >> 5] >> (codePoint & 31)) & 1;
+}
+
+/**
+ * Returns the simple case folding of the code point.
+ * @param codePoint
+ * @return Folded code point, or the code point itself if it does not fold.
+ */
+static uint32_t foldCodePoint(uint32_t codePoint)
+{
+    int low = 0;
+    int high = FOLD_RUN_COUNT - 1;
+    while (low <= high)
+    {
+        int mid = (low + high) / 2;
+        const FoldRun* run = &foldRuns[mid];
+        if (codePoint < run->start)
+        {
+            high = mid - 1;
+        }
+        else if (codePoint >= run->start + run->length * run->stride)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            if ((codePoint - run->start) % run->stride == 0)
+            {
+                return (uint32_t)((int32_t)codePoint + run->delta);
+            }
+            return codePoint;
+        }
+    }
+    return codePoint;
+}
+
+/**
+ * Makes room for at least extra more bytes in the current word.
+ * @param tokenizer
+ * @param extra
+ */
+static void reserveWord(Tokenizer* tokenizer, int extra)
+{
+    if (tokenizer->wordLength + extra + 1 > tokenizer->wordCapacity)
+    {
+        while (tokenizer->wordLength + extra + 1 > tokenizer->wordCapacity)
+        {
+            tokenizer->wordCapacity *= 2;
+        }
+        tokenizer->word = realloc(tokenizer->word, tokenizer->wordCapacity);
+        assert(tokenizer->word != 0);
+    }
+}
+
+/**
+ * Appends the UTF-8 encoding of the code point to the current word.
+ * @param tokenizer
+ * @param codePoint
+ */
+static void appendCodePoint(Tokenizer* tokenizer, uint32_t codePoint)
+{
+    reserveWord(tokenizer, MAX_SEQUENCE);
+    char* out = tokenizer->word + tokenizer->wordLength;
+    if (codePoint < 0x80)
+    {
+        out[0] = (char)codePoint;
+        tokenizer->wordLength += 1;
+    }
+    else if (codePoint < 0x800)
+    {
+        out[0] = (char)(0xC0 | (codePoint >> 6));
+        out[1] = (char)(0x80 | (codePoint & 0x3F));
+        tokenizer->wordLength += 2;
+    }
+    else if (codePoint < 0x10000)
+    {
+        out[0] = (char)(0xE0 | (codePoint >> 12));
+        out[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (codePoint & 0x3F));
+        tokenizer->wordLength += 3;
+    }
+    else
+    {
+        out[0] = (char)(0xF0 | (codePoint >> 18));
+        out[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (codePoint & 0x3F));
+        tokenizer->wordLength += 4;
+    }
+}
+
+/**
+ * Makes sure at least MAX_SEQUENCE bytes are buffered past pos unless the
+ * file has ended, moving the unread tail to the front and reading the next
+ * block.
+ * @param tokenizer
+ * @return Number of buffered bytes past pos.
+ */
+static int fillBuffer(Tokenizer* tokenizer)
+{
+    int available = tokenizer->end - tokenizer->pos;
+    if (available >= MAX_SEQUENCE || tokenizer->isEof)
+    {
+        return available;
+    }
+    tokenizer->base += tokenizer->pos;
+    memmove(tokenizer->buffer, tokenizer->buffer + tokenizer->pos, available);
+    PROFILE_BEGIN(PHASE_IO);
+    size_t read = fread(tokenizer->buffer + available, 1,
+                        BLOCK_SIZE - available, tokenizer->file);
+    PROFILE_COUNT(PHASE_IO, (long)read, 1);
+    PROFILE_END(PHASE_IO);
+    if (read < (size_t)(BLOCK_SIZE - available))
+    {
+        tokenizer->isEof = 1;
+    }
+    tokenizer->pos = 0;
+    tokenizer->end = available + (int)read;
+    tokenizer->asciiEnd = 0;
+    return tokenizer->end;
+}
+
+/**
+ * Returns 1 if the bytes from pos to the end of the file are the start of a
+ * UTF-8 sequence that more appended bytes could complete.
+ * @param tokenizer
+ * @return 1 if the input ends in a truncated sequence, 0 otherwise.
+ */
+static int isTruncatedTail(Tokenizer* tokenizer)
+{
+    const unsigned char* s = tokenizer->buffer + tokenizer->pos;
+    int available = tokenizer->end - tokenizer->pos;
+    if (!tokenizer->isEof || available >= MAX_SEQUENCE
+        || s[0] < 0xC2 || s[0] > 0xF4)
+    {
+        return 0;
+    }
+    for (int i = 1; i < available; i++)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+    return available < (s[0] >= 0xF0 ? 4 : s[0] >= 0xE0 ? 3 : 2);
+}
+
+/**
+ * Allocates a tokenizer reading from the given open file, starting at the
+ * file's current position. The tokenizer buffers ahead, so the file should
+ * not be read by anyone else meanwhile.
+ * @param file
+ * @param foldCase 1 to case fold every word, 0 to keep words as written.
+ * @return The tokenizer.
+ */
+Tokenizer* tokenizerNew(FILE* file, int foldCase)
+{
+    Tokenizer* tokenizer = malloc(sizeof(Tokenizer));
+    assert(tokenizer != 0);
+    tokenizer->file = file;
+    tokenizer->foldCase = foldCase;
+    tokenizer->isEof = 0;
+    tokenizer->buffer = malloc(BLOCK_SIZE);
+    assert(tokenizer->buffer != 0);
+    tokenizer->pos = 0;
+    tokenizer->end = 0;
+    tokenizer->asciiEnd = 0;
+    tokenizer->base = ftell(file);
+    if (tokenizer->base < 0)
+    {
+        tokenizer->base = 0;
+    }
+    tokenizer->wordStart = tokenizer->base;
+    tokenizer->committed = tokenizer->base;
+    tokenizer->isWordFinal = 1;
+    tokenizer->wordCapacity = 16;
+    tokenizer->wordLength = 0;
+    tokenizer->word = malloc(tokenizer->wordCapacity);
+    assert(tokenizer->word != 0);
+    tokenizer->invalidBytes = 0;
+    return tokenizer;
+}
+
+/**
+ * Frees the tokenizer. The file is left open.
+ * @param tokenizer
+ */
+void tokenizerDelete(Tokenizer* tokenizer)
+{
+    free(tokenizer->buffer);
+    free(tokenizer->word);
+    free(tokenizer);
+}
+
+/**
+ * Allocates a string for the next word in the file and returns it. This string
+ * is null terminated. Returns NULL after reaching the end of the file.
+ * @param tokenizer
+ * @return Allocated string or NULL.
+ */
+char* tokenizerNext(Tokenizer* tokenizer)
+{
+    tokenizer->wordLength = 0;
+    int isTruncated = 0;
+    int isInputEnd = 0;
+    while (1)
+    {
+        if (fillBuffer(tokenizer) == 0)
+        {
+            isInputEnd = 1;
+            break;
+        }
+        
+        /* ASCII run: no decoding needed. */
+        if (tokenizer->pos == tokenizer->asciiEnd)
+        {
+            tokenizer->asciiEnd = tokenizer->pos + asciiPrefixLength(
+                tokenizer->buffer + tokenizer->pos,
+                tokenizer->end - tokenizer->pos);
+        }
+        int stop = 0;
+        while (tokenizer->pos < tokenizer->asciiEnd)
+        {
+            unsigned char c = tokenizer->buffer[tokenizer->pos];
+            if (isAsciiWordChar(c))
+            {
+                if (tokenizer->wordLength == 0)
+                {
+                    tokenizer->wordStart = tokenizer->base + tokenizer->pos;
+                }
+                reserveWord(tokenizer, 1);
+                if (tokenizer->foldCase && c >= 'A' && c <= 'Z')
+                {
+                    c |= 0x20;
+                }
+                tokenizer->word[tokenizer->wordLength++] = (char)c;
+            }
+            else if (tokenizer->wordLength > 0)
+            {
+                stop = 1;
+                break;
+            }
+            tokenizer->pos++;
+        }
+        if (stop)
+        {
+            tokenizer->pos++;
+            break;
+        }
+        if (tokenizer->pos == tokenizer->end)
+        {
+            continue;
+        }
+        
+        /* Multibyte sequence. */
+        fillBuffer(tokenizer);
+        uint32_t codePoint;
+        int length = decodeUtf8(tokenizer->buffer + tokenizer->pos,
+                                tokenizer->end - tokenizer->pos, &codePoint);
+        if (length == 0 && isTruncatedTail(tokenizer))
+        {
+            /* Treat the partial sequence like the end of the file. */
+            isTruncated = 1;
+            isInputEnd = 1;
+            tokenizer->pos = tokenizer->end;
+            break;
+        }
+        if (length == 0)
+        {
+            tokenizer->invalidBytes++;
+            tokenizer->pos++;
+            tokenizer->asciiEnd = tokenizer->pos;
+            if (tokenizer->wordLength > 0)
+            {
+                break;
+            }
+            continue;
+        }
+        if (tokenizer->wordLength == 0)
+        {
+            tokenizer->wordStart = tokenizer->base + tokenizer->pos;
+        }
+        tokenizer->pos += length;
+        tokenizer->asciiEnd = tokenizer->pos;
+        if (isWordCodePoint(codePoint))
+        {
+            appendCodePoint(tokenizer, tokenizer->foldCase
+                            ? foldCodePoint(codePoint) : codePoint);
+        }
+        else if (tokenizer->wordLength > 0)
+        {
+            break;
+        }
+    }
+    
+    /* Once a word has been cut off, nothing past its start is final. */
+    if (isInputEnd && tokenizer->wordLength > 0)
+    {
+        tokenizer->isWordFinal = 0;
+        tokenizer->committed = tokenizer->wordStart;
+    }
+    else if (tokenizer->isWordFinal && !isTruncated)
+    {
+        tokenizer->committed = tokenizer->base + tokenizer->pos;
+    }
+    if (tokenizer->wordLength == 0)
+    {
+        return NULL;
+    }
+    char* word = malloc(tokenizer->wordLength + 1);
+    assert(word != 0);
+    memcpy(word, tokenizer->word, tokenizer->wordLength);
+    word[tokenizer->wordLength] = '\0';
+    return word;
+}
+
+/**
+ * Returns the number of malformed UTF-8 bytes skipped so far.
+ * @param tokenizer
+ * @return Number of invalid bytes.
+ */
+long tokenizerInvalidBytes(Tokenizer* tokenizer)
+{
+    return tokenizer->invalidBytes;
+}
+
+/**
+ * Returns 0 if the word last returned by tokenizerNext was cut off by the end
+ * of the file, so more appended text could still extend it, and 1 otherwise.
+ * @param tokenizer
+ * @return 1 if the last word is final.
+ */
+int tokenizerIsWordFinal(Tokenizer* tokenizer)
+{
+    return tokenizer->isWordFinal;
+}
+
+/**
+ * Returns the file offset up to which the text has been tokenized into final
+ * words. Resuming a tokenizer from this offset after the file has grown
+ * produces the words that follow without repeating or splitting any.
+ * @param tokenizer
+ * @return File offset.
+ */
+long tokenizerCommittedOffset(Tokenizer* tokenizer)
+{
+    return tokenizer->committed;
+}
+
+/**
+ * Returns the first word of a string, split and case folded exactly as
+ * tokenizerNext would. Words looked up in counts or an index built from
+ * tokenized text, such as query words, should go through this first.
+ * @param text
+ * @param foldCase 1 to case fold the word, 0 to keep it as written.
+ * @return Allocated string, or NULL if the text has no word.
+ */
+char* tokenizerWord(const char* text, int foldCase)
+{
+    size_t length = strlen(text);
+    if (length == 0)
+    {
+        return NULL;
+    }
+    FILE* file = fmemopen((void*)text, length, "r");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    Tokenizer* tokenizer = tokenizerNew(file, foldCase);
+    char* word = tokenizerNext(tokenizer);
+    tokenizerDelete(tokenizer);
+    fclose(file);
+    return word;
+}
@@ -0,0 +1,24 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * UTF-8 word tokenizer for the concordance program.
+ */
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stdio.h>
+
+typedef struct Tokenizer Tokenizer;
+
+Tokenizer* tokenizerNew(FILE* file, int foldCase);
+void tokenizerDelete(Tokenizer* tokenizer);
+
+char* tokenizerNext(Tokenizer* tokenizer);
+long tokenizerInvalidBytes(Tokenizer* tokenizer);
+int tokenizerIsWordFinal(Tokenizer* tokenizer);
+long tokenizerCommittedOffset(Tokenizer* tokenizer);
+
+char* tokenizerWord(const char* text, int foldCase);
+
+#endif
@@ -0,0 +1,719 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Unicode lookup tables for the tokenizer, generated from the Unicode 14.0.0
+ * character database.
+ *
+ * Word characters are the letters (L*), marks (M*) and decimal digits (Nd).
+ * They are stored as a two-stage table: wordBlockIndex maps a code point's
+ * high bits (cp >> 8) to one of the distinct 256-bit blocks in wordBlocks.
+ * Code points past the end of wordBlockIndex are never word characters.
+ *
+ * Simple case folding is stored as runs of code points that fold by the same
+ * delta, with a stride of 1 or 2 for the alternating upper/lower layout of
+ * the Latin and Cyrillic extension blocks.
+ */
+
+#ifndef TOKENIZER_TABLES_H
+#define TOKENIZER_TABLES_H
+
+#include <stdint.h>
+
+#define WORD_BLOCK_INDEX_SIZE 3586
+
+static const uint8_t wordBlockIndex[WORD_BLOCK_INDEX_SIZE] =
+{
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 1, 17, 18, 19, 1, 20, 21, 22, 23, 24, 25, 26, 1, 1, 27,
+    28, 29, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 31, 32, 33, 30,
+    34, 35, 30, 30, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 36, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 37, 1, 38, 39, 40, 41, 42, 43, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 44, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 1, 45, 46, 1, 47, 48, 49,
+    50, 51, 52, 53, 54, 55, 1, 56, 57, 58, 59, 60, 61, 62, 63, 64,
+    65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 30, 76, 77, 78, 79,
+    1, 1, 1, 80, 81, 82, 30, 30, 30, 30, 30, 30, 30, 30, 30, 83,
+    1, 1, 1, 1, 84, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 1, 1, 85, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 1, 1, 86, 87, 30, 30, 88, 89,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 90, 1, 1, 1, 1, 91, 92, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 93,
+    1, 94, 95, 30, 30, 30, 30, 30, 30, 30, 30, 30, 96, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 97,
+    30, 98, 99, 30, 100, 101, 102, 103, 30, 30, 104, 30, 30, 30, 30, 105,
+    106, 107, 108, 30, 30, 30, 30, 109, 110, 111, 30, 30, 30, 30, 112, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 113, 30, 30, 30, 30,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 114, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 115, 116, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 117, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 118, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 1, 1, 119, 30, 30, 30, 30, 30,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 120, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 121,
+};
+
+static const uint32_t wordBlocks[122][8] =
+{
+    { 0x00000000, 0x03ff0000, 0x07fffffe, 0x07fffffe,
+      0x00000000, 0x04200400, 0xff7fffff, 0xff7fffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0x0003ffc3, 0x0000501f },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xbcdfffff,
+      0xffffd740, 0xfffffffb, 0xffffffff, 0xffbfffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xfffffffb, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xfffeffff, 0x027fffff, 0xffffffff,
+      0xfffe01ff, 0xbfffffff, 0xffff00b6, 0x000787ff },
+    { 0x07ff0000, 0xffffffff, 0xffffffff, 0xffffc3ff,
+      0xffffffff, 0xffffffff, 0x9fefffff, 0x9ffffdff },
+    { 0xffff0000, 0xffffffff, 0xffffe7ff, 0xffffffff,
+      0xffffffff, 0x0003ffff, 0xffffffff, 0x243fffff },
+    { 0xffffffff, 0x00003fff, 0x0fffffff, 0xffff07ff,
+      0xff007eff, 0xffffffff, 0xffffffff, 0xfffffffb },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xfffeffcf,
+      0xfff99fef, 0xf3c5fdff, 0xb080799f, 0x5003ffcf },
+    { 0xfff987ee, 0xd36dfdff, 0x5e023987, 0x003fffc0,
+      0xfffbbfee, 0xf3edfdff, 0x00013bbf, 0xfe00ffcf },
+    { 0xfff99fee, 0xf3edfdff, 0xb0e0399f, 0x0002ffcf,
+      0xd63dc7ec, 0xc3ffc718, 0x00813dc7, 0x0000ffc0 },
+    { 0xfffddfff, 0xf3fffdff, 0x27603ddf, 0x0000ffcf,
+      0xfffddfef, 0xf3effdff, 0x60603ddf, 0x0006ffcf },
+    { 0xfffddfff, 0xffffffff, 0x80f07ddf, 0xfc00ffcf,
+      0xfc7fffee, 0x2ffbffff, 0xff5f847f, 0x000cffc0 },
+    { 0xfffffffe, 0x07ffffff, 0x03ff7fff, 0x00000000,
+      0xfffff7d6, 0x3fffffaf, 0xf3ff3f5f, 0x00000000 },
+    { 0x03000001, 0xc2a003ff, 0xfffffeff, 0xfffe1fff,
+      0xfeffffdf, 0x1fffffff, 0x00000040, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffff03ff, 0xffffffff,
+      0x3fffffff, 0xffffffff, 0xffff20bf, 0xf7ffffff },
+    { 0xffffffff, 0xffffffff, 0x3d7f3dff, 0xffffffff,
+      0xffff3dff, 0x7f3dffff, 0xff7fff3d, 0xffffffff },
+    { 0xff3dffff, 0xffffffff, 0xe7ffffff, 0x00000000,
+      0x0000ffff, 0xffffffff, 0xffffffff, 0x3f3fffff },
+    { 0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffff9fff,
+      0x07fffffe, 0xffffffff, 0xffffffff, 0x01fe07ff },
+    { 0x803fffff, 0x001fffff, 0x000fffff, 0x000ddfff,
+      0xffffffff, 0xffffffff, 0x308fffff, 0x000003ff },
+    { 0x03ffb800, 0xffffffff, 0xffffffff, 0x01ffffff,
+      0xffffffff, 0xffff07ff, 0xffffffff, 0x003fffff },
+    { 0x7fffffff, 0x0fff0fff, 0xffffffc0, 0x001f3fff,
+      0xffffffff, 0xffff0fff, 0x03ff03ff, 0x00000000 },
+    { 0x0fffffff, 0xffffffff, 0x7fffffff, 0x9fffffff,
+      0x03ff03ff, 0xffff0080, 0x00007fff, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0x03ff1fff, 0x000ff800,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x000fffff },
+    { 0xffffffff, 0x00ffffff, 0xffffe3ff, 0x3fffffff,
+      0xffff01ff, 0xe7ffffff, 0xfff70000, 0x07ffffff },
+    { 0x3f3fffff, 0xffffffff, 0xaaff3f3f, 0x3fffffff,
+      0xffffffff, 0x5fdfffff, 0x0fcf1fdc, 0x1fdc1fff },
+    { 0x00000000, 0x00000000, 0x00000000, 0x80020000,
+      0x1fff0000, 0x00000000, 0xffff0000, 0x0001ffff },
+    { 0x3e2ffc84, 0xf3ffbd50, 0x000043e0, 0x00000000,
+      0x00000018, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x000ff81f },
+    { 0xffffffff, 0xffff20bf, 0xffffffff, 0x800080ff,
+      0x007fffff, 0x7f7f7f7f, 0x7f7f7f7f, 0xffffffff },
+    { 0x00000000, 0x00008000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000060, 0x183efc00, 0xfffffffe, 0xffffffff,
+      0xe67fffff, 0xfffffffe, 0xffffffff, 0xf7ffffff },
+    { 0xffffffe0, 0xfffeffff, 0xffffffff, 0xffffffff,
+      0x00007fff, 0xffffffff, 0x00000000, 0xffff0000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0x00001fff, 0x00000000, 0xffff0000, 0x3fffffff },
+    { 0xffff1fff, 0x00000fff, 0xffffffff, 0xbff7ffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x0003003f },
+    { 0xff800000, 0xfffffffc, 0xffffffff, 0xffffffff,
+      0xfffff9ff, 0xffffffff, 0x03eb07ff, 0xfffc0000 },
+    { 0xffffffff, 0x000010ff, 0xffffffff, 0x000fffff,
+      0xffffffff, 0xffffffff, 0x03ff003f, 0xe8ffffff },
+    { 0xffffffff, 0xffff3fff, 0x000fffff, 0x1fffffff,
+      0xffffffff, 0xffffffff, 0x03ff8001, 0x7fffffff },
+    { 0xffffffff, 0x007fffff, 0x03ff3fff, 0xfc7fffff,
+      0xffffffff, 0xffffffff, 0x38000007, 0x007cffff },
+    { 0x007e7e7e, 0xffff7f7f, 0xf7ffffff, 0xffff03ff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x03ff37ff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffff000f, 0xfffff87f, 0x0fffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffff3fff,
+      0xffffffff, 0xffffffff, 0x03ffffff, 0x00000000 },
+    { 0xe0f8007f, 0x5f7ffdff, 0xffffffdb, 0xffffffff,
+      0xffffffff, 0x0003ffff, 0xfff80000, 0xffffffff },
+    { 0xffffffff, 0x3fffffff, 0xffff0000, 0xffffffff,
+      0xfffcffff, 0xffffffff, 0x000000ff, 0x0fff0000 },
+    { 0x0000ffff, 0x0000ffff, 0x00000000, 0xffdf0000,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x1fffffff },
+    { 0x03ff0000, 0x07fffffe, 0x07fffffe, 0xffffffc0,
+      0xffffffff, 0x7fffffff, 0x1cfcfcfc, 0x00000000 },
+    { 0xffffefff, 0xb7ffff7f, 0x3fff3fff, 0x00000000,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x07ffffff },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x20000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x1fffffff, 0xffffffff, 0x0001ffff, 0x00000001 },
+    { 0xffffffff, 0xffffe000, 0xffff03fd, 0x07ffffff,
+      0x3fffffff, 0xffffffff, 0x0000ff0f, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0x3fffffff, 0xffff03ff, 0xff0fffff, 0x0fffffff },
+    { 0xffffffff, 0xffff00ff, 0xffffffff, 0xf7ff000f,
+      0xffb7f7ff, 0x1bfbfffb, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0x007fffff, 0x003fffff, 0x000000ff,
+      0xffffffbf, 0x07fdffff, 0x00000000, 0x00000000 },
+    { 0xfffffd3f, 0x91bfffff, 0x003fffff, 0x007fffff,
+      0x7fffffff, 0x00000000, 0x00000000, 0x0037ffff },
+    { 0x003fffff, 0x03ffffff, 0x00000000, 0x00000000,
+      0xffffffff, 0xc0ffffff, 0x00000000, 0x00000000 },
+    { 0xfeeff06f, 0x873fffff, 0x00000000, 0x1fffffff,
+      0x1fffffff, 0x00000000, 0xfffffeff, 0x0000007f },
+    { 0xffffffff, 0x003fffff, 0x003fffff, 0x0007ffff,
+      0x0003ffff, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0x000001ff, 0x00000000,
+      0xffffffff, 0x0007ffff, 0xffffffff, 0x0007ffff },
+    { 0xffffffff, 0x03ff00ff, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0xffffffff, 0x00031bff, 0x00000000, 0x00000000 },
+    { 0x1fffffff, 0xffff0080, 0x0001ffff, 0xffff0000,
+      0x0000003f, 0xffff0000, 0x0000001f, 0x007fffff },
+    { 0xffffffff, 0xffffffff, 0x0000007f, 0x803fffc0,
+      0xffffffff, 0x07ffffff, 0xffff0004, 0x03ff01ff },
+    { 0xffffffff, 0xffdfffff, 0xffff00f0, 0x004fffff,
+      0xffffffff, 0xffffffff, 0x17ffde1f, 0x00000000 },
+    { 0xfffbffff, 0x40ffffff, 0x00000000, 0x00000000,
+      0xbfffbd7f, 0xffff01ff, 0xffffffff, 0x03ff07ff },
+    { 0xfff99fef, 0xfbedfdff, 0xe081399f, 0x001f1fcf,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xc3ff07ff, 0x00000003,
+      0xffffffff, 0xffffffff, 0x03ff00bf, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0xffffffff, 0xff3fffff, 0x3f000001, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0x03ff0011, 0x00000000,
+      0xffffffff, 0x01ffffff, 0x000003ff, 0x00000000 },
+    { 0xe7ffffff, 0x03ff0fff, 0x0000007f, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0x07ffffff, 0x00000000, 0x00000000,
+      0x00000000, 0xffffffff, 0xffffffff, 0x800003ff },
+    { 0xff6ff27f, 0xf9bfffff, 0x03ff000f, 0x00000000,
+      0x00000000, 0xfffffcff, 0xfcffffff, 0x0000001b },
+    { 0xffffffff, 0x7fffffff, 0xffff0080, 0xffffffff,
+      0x23ffffff, 0xffff0000, 0xffffffff, 0x01ffffff },
+    { 0xfffffdff, 0xff7fffff, 0x03ff0001, 0xfffc0000,
+      0xfffcffff, 0x007ffeff, 0x00000000, 0x00000000 },
+    { 0xfffffb7f, 0xb47fffff, 0x03ff00ff, 0xfffffdbf,
+      0x01fb7fff, 0x000003ff, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x007fffff },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00010000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0x03ffffff, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0x0000000f, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0xffff0000, 0xffffffff, 0xffffffff, 0x0001ffff },
+    { 0xffffffff, 0x00007fff, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0x0000007f, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0x01ffffff, 0x7fffffff, 0xffff03ff,
+      0xffffffff, 0x7fffffff, 0xffff03ff, 0x001f3fff },
+    { 0xffffffff, 0x007fffff, 0x03ff000f, 0xe0fffff8,
+      0x0000ffff, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0xffffffff, 0xffffffff,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffff87ff, 0xffffffff,
+      0xffff80ff, 0x00000000, 0x00000000, 0x0003001b },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x00ffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0x003fffff, 0x00000000 },
+    { 0x000001ff, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x6fef0000 },
+    { 0xffffffff, 0x00000007, 0x00070000, 0xffff00f0,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x0fffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0x1fff07ff,
+      0x63ff01ff, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffff3fff, 0x0000007f, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0xf807e3e0,
+      0x00000fe7, 0x00003c00, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x0000001c, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffdfffff, 0xffffffff,
+      0xdfffffff, 0xebffde64, 0xffffffef, 0xffffffff },
+    { 0xdfdfe7bf, 0x7bffffff, 0xfffdfc5f, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffff3f, 0xf7fffffd, 0xf7ffffff },
+    { 0xffdfffff, 0xffdfffff, 0xffff7fff, 0xffff7fff,
+      0xfffffdff, 0xfffffdff, 0xffffcff7, 0xffffffff },
+    { 0xffffffff, 0xf87fffff, 0xffffffff, 0x00201fff,
+      0xf8000010, 0x0000fffe, 0x00000000, 0x00000000 },
+    { 0x7fffffff, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xf9ffff7f, 0x000007db, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0x3fff1fff, 0x000043ff, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0xffff0000, 0x00007fff, 0xffffffff, 0x03ffffff },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x7fff6f7f },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0x007f001f, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0x03ff0fff, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffef, 0x0af7fe96, 0xaa96ea84, 0x5ef7f796,
+      0x0ffffbff, 0x0ffffbee, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x03ff0000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x00000000 },
+    { 0xffffffff, 0x01ffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0x3fffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffff0003, 0xffffffff, 0xffffffff },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x00000001 },
+    { 0x3fffffff, 0x00000000, 0x00000000, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0x000007ff, 0x00000000,
+      0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0xffffffff, 0xffffffff, 0xffffffff, 0x0000ffff },
+};
+
+typedef struct FoldRun FoldRun;
+
+struct FoldRun
+{
+    uint32_t start;
+    uint16_t length;
+    uint16_t stride;
+    int32_t delta;
+};
+
+#define FOLD_RUN_COUNT 202
+
+static const FoldRun foldRuns[FOLD_RUN_COUNT] =
+{
+    { 0x00041, 26, 1, 32 },
+    { 0x000b5, 1, 1, 775 },
+    { 0x000c0, 23, 1, 32 },
+    { 0x000d8, 7, 1, 32 },
+    { 0x00100, 24, 2, 1 },
+    { 0x00132, 3, 2, 1 },
+    { 0x00139, 8, 2, 1 },
+    { 0x0014a, 23, 2, 1 },
+    { 0x00178, 1, 1, -121 },
+    { 0x00179, 3, 2, 1 },
+    { 0x0017f, 1, 1, -268 },
+    { 0x00181, 1, 1, 210 },
+    { 0x00182, 2, 2, 1 },
+    { 0x00186, 1, 1, 206 },
+    { 0x00187, 1, 1, 1 },
+    { 0x00189, 2, 1, 205 },
+    { 0x0018b, 1, 1, 1 },
+    { 0x0018e, 1, 1, 79 },
+    { 0x0018f, 1, 1, 202 },
+    { 0x00190, 1, 1, 203 },
+    { 0x00191, 1, 1, 1 },
+    { 0x00193, 1, 1, 205 },
+    { 0x00194, 1, 1, 207 },
+    { 0x00196, 1, 1, 211 },
+    { 0x00197, 1, 1, 209 },
+    { 0x00198, 1, 1, 1 },
+    { 0x0019c, 1, 1, 211 },
+    { 0x0019d, 1, 1, 213 },
+    { 0x0019f, 1, 1, 214 },
+    { 0x001a0, 3, 2, 1 },
+    { 0x001a6, 1, 1, 218 },
+    { 0x001a7, 1, 1, 1 },
+    { 0x001a9, 1, 1, 218 },
+    { 0x001ac, 1, 1, 1 },
+    { 0x001ae, 1, 1, 218 },
+    { 0x001af, 1, 1, 1 },
+    { 0x001b1, 2, 1, 217 },
+    { 0x001b3, 2, 2, 1 },
+    { 0x001b7, 1, 1, 219 },
+    { 0x001b8, 1, 1, 1 },
+    { 0x001bc, 1, 1, 1 },
+    { 0x001c4, 1, 1, 2 },
+    { 0x001c5, 1, 1, 1 },
+    { 0x001c7, 1, 1, 2 },
+    { 0x001c8, 1, 1, 1 },
+    { 0x001ca, 1, 1, 2 },
+    { 0x001cb, 9, 2, 1 },
+    { 0x001de, 9, 2, 1 },
+    { 0x001f1, 1, 1, 2 },
+    { 0x001f2, 2, 2, 1 },
+    { 0x001f6, 1, 1, -97 },
+    { 0x001f7, 1, 1, -56 },
+    { 0x001f8, 20, 2, 1 },
+    { 0x00220, 1, 1, -130 },
+    { 0x00222, 9, 2, 1 },
+    { 0x0023a, 1, 1, 10795 },
+    { 0x0023b, 1, 1, 1 },
+    { 0x0023d, 1, 1, -163 },
+    { 0x0023e, 1, 1, 10792 },
+    { 0x00241, 1, 1, 1 },
+    { 0x00243, 1, 1, -195 },
+    { 0x00244, 1, 1, 69 },
+    { 0x00245, 1, 1, 71 },
+    { 0x00246, 5, 2, 1 },
+    { 0x00345, 1, 1, 116 },
+    { 0x00370, 2, 2, 1 },
+    { 0x00376, 1, 1, 1 },
+    { 0x0037f, 1, 1, 116 },
+    { 0x00386, 1, 1, 38 },
+    { 0x00388, 3, 1, 37 },
+    { 0x0038c, 1, 1, 64 },
+    { 0x0038e, 2, 1, 63 },
+    { 0x00391, 17, 1, 32 },
+    { 0x003a3, 9, 1, 32 },
+    { 0x003c2, 1, 1, 1 },
+    { 0x003cf, 1, 1, 8 },
+    { 0x003d0, 1, 1, -30 },
+    { 0x003d1, 1, 1, -25 },
+    { 0x003d5, 1, 1, -15 },
+    { 0x003d6, 1, 1, -22 },
+    { 0x003d8, 12, 2, 1 },
+    { 0x003f0, 1, 1, -54 },
+    { 0x003f1, 1, 1, -48 },
+    { 0x003f4, 1, 1, -60 },
+    { 0x003f5, 1, 1, -64 },
+    { 0x003f7, 1, 1, 1 },
+    { 0x003f9, 1, 1, -7 },
+    { 0x003fa, 1, 1, 1 },
+    { 0x003fd, 3, 1, -130 },
+    { 0x00400, 16, 1, 80 },
+    { 0x00410, 32, 1, 32 },
+    { 0x00460, 17, 2, 1 },
+    { 0x0048a, 27, 2, 1 },
+    { 0x004c0, 1, 1, 15 },
+    { 0x004c1, 7, 2, 1 },
+    { 0x004d0, 48, 2, 1 },
+    { 0x00531, 38, 1, 48 },
+    { 0x010a0, 38, 1, 7264 },
+    { 0x010c7, 1, 1, 7264 },
+    { 0x010cd, 1, 1, 7264 },
+    { 0x013f8, 6, 1, -8 },
+    { 0x01c80, 1, 1, -6222 },
+    { 0x01c81, 1, 1, -6221 },
+    { 0x01c82, 1, 1, -6212 },
+    { 0x01c83, 2, 1, -6210 },
+    { 0x01c85, 1, 1, -6211 },
+    { 0x01c86, 1, 1, -6204 },
+    { 0x01c87, 1, 1, -6180 },
+    { 0x01c88, 1, 1, 35267 },
+    { 0x01c90, 43, 1, -3008 },
+    { 0x01cbd, 3, 1, -3008 },
+    { 0x01e00, 75, 2, 1 },
+    { 0x01e9b, 1, 1, -58 },
+    { 0x01e9e, 1, 1, -7615 },
+    { 0x01ea0, 48, 2, 1 },
+    { 0x01f08, 8, 1, -8 },
+    { 0x01f18, 6, 1, -8 },
+    { 0x01f28, 8, 1, -8 },
+    { 0x01f38, 8, 1, -8 },
+    { 0x01f48, 6, 1, -8 },
+    { 0x01f59, 4, 2, -8 },
+    { 0x01f68, 8, 1, -8 },
+    { 0x01f88, 8, 1, -8 },
+    { 0x01f98, 8, 1, -8 },
+    { 0x01fa8, 8, 1, -8 },
+    { 0x01fb8, 2, 1, -8 },
+    { 0x01fba, 2, 1, -74 },
+    { 0x01fbc, 1, 1, -9 },
+    { 0x01fbe, 1, 1, -7173 },
+    { 0x01fc8, 4, 1, -86 },
+    { 0x01fcc, 1, 1, -9 },
+    { 0x01fd8, 2, 1, -8 },
+    { 0x01fda, 2, 1, -100 },
+    { 0x01fe8, 2, 1, -8 },
+    { 0x01fea, 2, 1, -112 },
+    { 0x01fec, 1, 1, -7 },
+    { 0x01ff8, 2, 1, -128 },
+    { 0x01ffa, 2, 1, -126 },
+    { 0x01ffc, 1, 1, -9 },
+    { 0x02126, 1, 1, -7517 },
+    { 0x0212a, 1, 1, -8383 },
+    { 0x0212b, 1, 1, -8262 },
+    { 0x02132, 1, 1, 28 },
+    { 0x02160, 16, 1, 16 },
+    { 0x02183, 1, 1, 1 },
+    { 0x024b6, 26, 1, 26 },
+    { 0x02c00, 48, 1, 48 },
+    { 0x02c60, 1, 1, 1 },
+    { 0x02c62, 1, 1, -10743 },
+    { 0x02c63, 1, 1, -3814 },
+    { 0x02c64, 1, 1, -10727 },
+    { 0x02c67, 3, 2, 1 },
+    { 0x02c6d, 1, 1, -10780 },
+    { 0x02c6e, 1, 1, -10749 },
+    { 0x02c6f, 1, 1, -10783 },
+    { 0x02c70, 1, 1, -10782 },
+    { 0x02c72, 1, 1, 1 },
+    { 0x02c75, 1, 1, 1 },
+    { 0x02c7e, 2, 1, -10815 },
+    { 0x02c80, 50, 2, 1 },
+    { 0x02ceb, 2, 2, 1 },
+    { 0x02cf2, 1, 1, 1 },
+    { 0x0a640, 23, 2, 1 },
+    { 0x0a680, 14, 2, 1 },
+    { 0x0a722, 7, 2, 1 },
+    { 0x0a732, 31, 2, 1 },
+    { 0x0a779, 2, 2, 1 },
+    { 0x0a77d, 1, 1, -35332 },
+    { 0x0a77e, 5, 2, 1 },
+    { 0x0a78b, 1, 1, 1 },
+    { 0x0a78d, 1, 1, -42280 },
+    { 0x0a790, 2, 2, 1 },
+    { 0x0a796, 10, 2, 1 },
+    { 0x0a7aa, 1, 1, -42308 },
+    { 0x0a7ab, 1, 1, -42319 },
+    { 0x0a7ac, 1, 1, -42315 },
+    { 0x0a7ad, 1, 1, -42305 },
+    { 0x0a7ae, 1, 1, -42308 },
+    { 0x0a7b0, 1, 1, -42258 },
+    { 0x0a7b1, 1, 1, -42282 },
+    { 0x0a7b2, 1, 1, -42261 },
+    { 0x0a7b3, 1, 1, 928 },
+    { 0x0a7b4, 8, 2, 1 },
+    { 0x0a7c4, 1, 1, -48 },
+    { 0x0a7c5, 1, 1, -42307 },
+    { 0x0a7c6, 1, 1, -35384 },
+    { 0x0a7c7, 2, 2, 1 },
+    { 0x0a7d0, 1, 1, 1 },
+    { 0x0a7d6, 2, 2, 1 },
+    { 0x0a7f5, 1, 1, 1 },
+    { 0x0ab70, 80, 1, -38864 },
+    { 0x0ff21, 26, 1, 32 },
+    { 0x10400, 40, 1, 40 },
+    { 0x104b0, 36, 1, 40 },
+    { 0x10570, 11, 1, 39 },
+    { 0x1057c, 15, 1, 39 },
+    { 0x1058c, 7, 1, 39 },
+    { 0x10594, 2, 1, 39 },
+    { 0x10c80, 51, 1, 64 },
+    { 0x118a0, 32, 1, 32 },
+    { 0x16e40, 32, 1, 32 },
+    { 0x1e900, 34, 1, 34 },
+};
+
+#endif
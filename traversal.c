@@ -0,0 +1,232 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * TraversalContext implementation file.
+ */
+
+#include "traversal.h"
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+
+/* Queries a worker claims at a time from the shared counter. */
+#define QUERY_CHUNK 16
+
+/* Context used by the searches that are not given one, freed at exit. */
+static TraversalContext* defaultContext = NULL;
+static int defaultContextRegistered = 0;
+
+/**
+ * Allocates a traversal context for graphs of up to numVertices vertices.
+ * It grows on reset if used with a larger graph.
+ * @param numVertices
+ * @return The context.
+ */
+TraversalContext* traversalContextNew(int numVertices)
+{
+    assert(numVertices >= 0);
+    TraversalContext* context = malloc(sizeof(TraversalContext));
+    assert(context != 0);
+    context->visited = visitedSetNew(numVertices);
+    context->reverseVisited = visitedSetNew(numVertices);
+    context->buffer = malloc(sizeof(uint32_t) * (numVertices + 1));
+    context->distances = malloc(sizeof(int) * (numVertices + 1));
+    assert(context->buffer != 0 && context->distances != 0);
+    context->capacity = numVertices;
+    return context;
+}
+
+/**
+ * Frees the context.
+ * @param context
+ */
+void traversalContextDelete(TraversalContext* context)
+{
+    visitedSetDelete(context->visited);
+    visitedSetDelete(context->reverseVisited);
+    free(context->buffer);
+    free(context->distances);
+    free(context);
+}
+
+/**
+ * Prepares the context for a new traversal of a graph with numVertices
+ * vertices: no vertex is visited.
+ * @param context
+ * @param numVertices
+ */
+void traversalContextReset(TraversalContext* context, int numVertices)
+{
+    visitedSetReserve(context->visited, numVertices);
+    visitedSetClear(context->visited);
+    visitedSetReserve(context->reverseVisited, numVertices);
+    visitedSetClear(context->reverseVisited);
+    if (numVertices > context->capacity)
+    {
+        context->buffer = realloc(context->buffer,
+                                  sizeof(uint32_t) * (numVertices + 1));
+        context->distances = realloc(context->distances,
+                                     sizeof(int) * (numVertices + 1));
+        assert(context->buffer != 0 && context->distances != 0);
+        context->capacity = numVertices;
+    }
+}
+
+/**
+ * Returns the context shared by the searches that are not given one, such
+ * as dfsIterative and csrBfsIterative, allocating it on first use. Those
+ * searches are therefore single-threaded: to search from several threads at
+ * once, give each thread its own context and use the Context functions. The
+ * context lives until the program exits, whatever graphs are freed.
+ * @return The default context.
+ */
+TraversalContext* traversalDefaultContext(void)
+{
+    if (defaultContext == NULL)
+    {
+        defaultContext = traversalContextNew(0);
+        if (!defaultContextRegistered)
+        {
+            defaultContextRegistered = atexit(traversalDefaultContextDelete)
+                                       == 0;
+        }
+    }
+    return defaultContext;
+}
+
+/**
+ * Frees the default context, if allocated. This runs at exit, and may also
+ * be called earlier once no search is using the context; the next search
+ * then allocates a new one.
+ */
+void traversalDefaultContextDelete(void)
+{
+    if (defaultContext != NULL)
+    {
+        traversalContextDelete(defaultContext);
+        defaultContext = NULL;
+    }
+}
+
+typedef struct QueryTask QueryTask;
+
+/**
+ * Shared by all workers of one parallel run. Exactly one of graph and
+ * csrGraph is set.
+ */
+struct QueryTask
+{
+    Graph* graph;
+    GraphSearchFunction search;
+    CsrGraph* csrGraph;
+    CsrSearchFunction csrSearch;
+    ReachabilityQuery* queries;
+    int numQueries;
+    int next;
+};
+
+/**
+ * Worker thread. Claims chunks of queries until none are left, answering
+ * them with its own context, so uneven query costs balance out.
+ * @param arg The QueryTask.
+ * @return NULL
+ */
+static void* queryWorker(void* arg)
+{
+    QueryTask* task = arg;
+    int numVertices = task->graph != NULL ? task->graph->numVertices
+                                          : task->csrGraph->numVertices;
+    TraversalContext* context = traversalContextNew(numVertices);
+    int begin;
+    while ((begin = __sync_fetch_and_add(&task->next, QUERY_CHUNK))
+           < task->numQueries)
+    {
+        int end = begin + QUERY_CHUNK;
+        if (end > task->numQueries)
+        {
+            end = task->numQueries;
+        }
+        for (int i = begin; i < end; ++i)
+        {
+            ReachabilityQuery* query = &task->queries[i];
+            if (task->graph != NULL)
+            {
+                Vertex* vertexSet = task->graph->vertexSet;
+                query->reachable = task->search(task->graph, context,
+                                                &vertexSet[query->source],
+                                                &vertexSet[query->destination]);
+            }
+            else
+            {
+                query->reachable = task->csrSearch(task->csrGraph, context,
+                                                   query->source,
+                                                   query->destination);
+            }
+        }
+    }
+    traversalContextDelete(context);
+    return NULL;
+}
+
+/**
+ * Runs the task on numThreads threads, one of them the calling thread.
+ * @param task
+ * @param numThreads
+ */
+static void runQueries(QueryTask* task, int numThreads)
+{
+    assert(numThreads > 0);
+    task->next = 0;
+    pthread_t* threads = malloc(sizeof(pthread_t) * numThreads);
+    assert(threads != 0);
+    /* Workers claim queries as they go, so if some fail to start the others
+     * answer their share. */
+    int started = 1;
+    while (started < numThreads &&
+           pthread_create(&threads[started], NULL, queryWorker, task) == 0)
+    {
+        ++started;
+    }
+    queryWorker(task);
+    for (int t = 1; t < started; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+}
+
+/**
+ * Answers every query with the given search, using numThreads threads that
+ * share the graph and each own a traversal context. The graph must not be
+ * modified until this returns. Sets each query's reachable field.
+ * @param graph
+ * @param queries
+ * @param numQueries
+ * @param search For example bfsIterativeContext.
+ * @param numThreads Number of worker threads, at least 1.
+ */
+void graphQueryParallel(Graph* graph, ReachabilityQuery* queries,
+                        int numQueries, GraphSearchFunction search,
+                        int numThreads)
+{
+    assert(graph != 0 && search != 0);
+    QueryTask task = {graph, search, NULL, NULL, queries, numQueries, 0};
+    runQueries(&task, numThreads);
+}
+
+/**
+ * Same as graphQueryParallel for a CSR graph.
+ * @param graph
+ * @param queries
+ * @param numQueries
+ * @param search For example csrBfsIterativeContext.
+ * @param numThreads Number of worker threads, at least 1.
+ */
+void csrQueryParallel(CsrGraph* graph, ReachabilityQuery* queries,
+                      int numQueries, CsrSearchFunction search,
+                      int numThreads)
+{
+    assert(graph != 0 && search != 0);
+    QueryTask task = {NULL, NULL, graph, search, queries, numQueries, 0};
+    runQueries(&task, numThreads);
+}
@@ -0,0 +1,84 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Per-query traversal state and parallel reachability queries.
+ */
+
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include "graph.h"
+#include "csrGraph.h"
+#include "visitedSet.h"
+#include <stdint.h>
+
+typedef struct TraversalContext TraversalContext;
+typedef struct ReachabilityQuery ReachabilityQuery;
+
+/**
+ * Everything a traversal writes to. The graph is only read, so any number of
+ * searches can run on one graph at once as long as each has its own context.
+ * A context is reused from query to query without reallocating.
+ * Iterative searches use buffer, one slot per vertex, as their stack or
+ * queue of vertex indices.
+ * Bidirectional searches mark the destination's side in reverseVisited and
+ * keep each vertex's distance from its own endpoint in distances.
+ */
+struct TraversalContext
+{
+    VisitedSet* visited;
+    VisitedSet* reverseVisited;
+    uint32_t* buffer;
+    int* distances;
+    int capacity;
+};
+
+/**
+ * A source-destination pair, by vertex index, and whether the destination
+ * is reachable from the source.
+ */
+struct ReachabilityQuery
+{
+    int source;
+    int destination;
+    int reachable;
+};
+
+typedef int (*GraphSearchFunction)(Graph*, TraversalContext*, Vertex*,
+                                   Vertex*);
+typedef int (*CsrSearchFunction)(CsrGraph*, TraversalContext*, int, int);
+
+int bfsBidirectional(Graph* graph, Vertex* source, Vertex* destination);
+int bfsPathLength(Graph* graph, Vertex* source, Vertex* destination);
+
+TraversalContext* traversalContextNew(int numVertices);
+void traversalContextDelete(TraversalContext* context);
+void traversalContextReset(TraversalContext* context, int numVertices);
+TraversalContext* traversalDefaultContext(void);
+void traversalDefaultContextDelete(void);
+
+int dfsRecursiveContext(Graph* graph, TraversalContext* context,
+                        Vertex* source, Vertex* destination);
+int dfsIterativeContext(Graph* graph, TraversalContext* context,
+                        Vertex* source, Vertex* destination);
+int bfsIterativeContext(Graph* graph, TraversalContext* context,
+                        Vertex* source, Vertex* destination);
+int bfsBidirectionalContext(Graph* graph, TraversalContext* context,
+                            Vertex* source, Vertex* destination);
+int bfsPathLengthContext(Graph* graph, TraversalContext* context,
+                         Vertex* source, Vertex* destination);
+int csrDfsRecursiveContext(CsrGraph* graph, TraversalContext* context,
+                           int source, int destination);
+int csrDfsIterativeContext(CsrGraph* graph, TraversalContext* context,
+                           int source, int destination);
+int csrBfsIterativeContext(CsrGraph* graph, TraversalContext* context,
+                           int source, int destination);
+
+void graphQueryParallel(Graph* graph, ReachabilityQuery* queries,
+                        int numQueries, GraphSearchFunction search,
+                        int numThreads);
+void csrQueryParallel(CsrGraph* graph, ReachabilityQuery* queries,
+                      int numQueries, CsrSearchFunction search,
+                      int numThreads);
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * VisitedSet implementation file.
+ */
+
+#include "visitedSet.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * Allocates an empty visited set for vertices 0 to size - 1.
+ * @param size
+ * @return The set.
+ */
+VisitedSet* visitedSetNew(int size)
+{
+    assert(size >= 0);
+    VisitedSet* set = malloc(sizeof(VisitedSet));
+    assert(set != 0);
+    set->stamps = calloc(size + 1, sizeof(uint32_t));
+    assert(set->stamps != 0);
+    set->epoch = 1;
+    set->size = size;
+    return set;
+}
+
+/**
+ * Frees the set.
+ * @param set
+ */
+void visitedSetDelete(VisitedSet* set)
+{
+    free(set->stamps);
+    free(set);
+}
+
+/**
+ * Grows the set to hold at least size vertices. New vertices are unvisited.
+ * @param set
+ * @param size
+ */
+void visitedSetReserve(VisitedSet* set, int size)
+{
+    if (size <= set->size)
+    {
+        return;
+    }
+    set->stamps = realloc(set->stamps, sizeof(uint32_t) * (size + 1));
+    assert(set->stamps != 0);
+    memset(set->stamps + set->size, 0, sizeof(uint32_t) * (size - set->size));
+    set->size = size;
+}
+
+/**
+ * Marks every vertex unvisited in constant time. Only when the epoch counter
+ * wraps around, once every 2^32 - 1 clears, are the stamps actually zeroed.
+ * @param set
+ */
+void visitedSetClear(VisitedSet* set)
+{
+    set->epoch++;
+    if (set->epoch == 0)
+    {
+        memset(set->stamps, 0, sizeof(uint32_t) * set->size);
+        set->epoch = 1;
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * CS 261 Data Structures
+ * Name: Patrick Mullaney
+ * Visited set for graph traversals with constant time reset.
+ */
+
+#ifndef VISITED_SET_H
+#define VISITED_SET_H
+
+#include <stdint.h>
+
+typedef struct VisitedSet VisitedSet;
+
+/**
+ * Vertex i is visited if stamps[i] == epoch. Clearing the set only advances
+ * the epoch, so a traversal that touches k vertices costs O(k), not O(V).
+ */
+struct VisitedSet
+{
+    uint32_t* stamps;
+    uint32_t epoch;
+    int size;
+};
+
+VisitedSet* visitedSetNew(int size);
+void visitedSetDelete(VisitedSet* set);
+void visitedSetReserve(VisitedSet* set, int size);
+void visitedSetClear(VisitedSet* set);
+
+static inline int visitedSetContains(VisitedSet* set, int i)
+{
+    return set->stamps[i] == set->epoch;
+}
+
+static inline void visitedSetAdd(VisitedSet* set, int i)
+{
+    set->stamps[i] = set->epoch;
+}
+
+#endif